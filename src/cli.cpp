@@ -0,0 +1,523 @@
+#include "cli.h"
+#include "dat151.h"
+#include "door_daemon.h"
+#include "door_manifest.h"
+#include "export_cache.h"
+#include "joaat.h"
+#include "mapped_file.h"
+#include "preset_index.h"
+#include "settings_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+    const int EXIT_OK = 0;
+    const int EXIT_FAILED = 1;
+    const int EXIT_USAGE = 2;
+
+    // Path standing for stdin or stdout
+    const char* STANDARD_STREAM = "-";
+
+    void printUsage(const char* program) {
+        std::cerr
+            << "Usage:\n"
+            << "  " << program << " export [--settings FILE] [--output FILE] [--cache DIR] MANIFEST...\n"
+            << "  " << program << " import [--output FILE] DAT151_XML...\n"
+            << "  " << program << " serve [--settings FILE] [--cache DIR] SOCKET\n"
+            << "  " << program << " request [--output FILE] SOCKET REQUEST [FILE...]\n"
+            << "\n"
+            << "Commands:\n"
+            << "  export    Write a dat151.rel.xml file for each door manifest\n"
+            << "  import    List the doors of dat151.rel.xml files as JSON lines\n"
+            << "  serve     Answer export, import and validate requests on a Unix socket (see door_daemon.h)\n"
+            << "  request   Send one request to a serve daemon, REQUEST being one of\n"
+            << "              export MANIFEST              dat151.rel.xml to the output\n"
+            << "              export-file MANIFEST OUTPUT  written by the daemon, skipped when cached\n"
+            << "              import DAT151_XML            JSON lines to the output\n"
+            << "              validate MANIFEST\n"
+            << "              shutdown\n"
+            << "\n"
+            << "Options:\n"
+            << "  --settings FILE  settings.json with the presets manifests refer to\n"
+            << "                   (default: assets/settings.json next to the executable)\n"
+            << "  --output FILE    Output file, only with a single manifest\n"
+            << "                   (export default: the manifest path with a .dat151.rel.xml extension,\n"
+            << "                   import and request default: stdout)\n"
+            << "  --cache DIR      Skip exports whose manifest, presets and output did not change\n"
+            << "                   since the last export recorded in DIR\n"
+            << "\n"
+            << "A '-' input reads stdin and a '-' output writes stdout. Manifests read from\n"
+            << "stdin are JSON lines, one door per line, and are exported to stdout by default.\n"
+            << "The paths of an export-file request are made absolute before they are sent,\n"
+            << "the daemon would resolve relative paths against its own working directory.\n";
+    }
+
+    // "doors/level1.json" -> "doors/level1.dat151.rel.xml"
+    std::string defaultOutputPath(const std::string& manifestPath) {
+        if (manifestPath == STANDARD_STREAM) {
+            return STANDARD_STREAM;
+        }
+        std::filesystem::path path(manifestPath);
+        path.replace_extension(".dat151.rel.xml");
+        return path.string();
+    }
+
+    /**
+     * Destination of a command, either stdout or a file
+     * Files are written next to their final path and only replace it once
+     * complete, like writeDat151File.
+     */
+    class Output {
+    public:
+        ~Output() {
+            if (file && file != stdout) {
+                std::fclose(file);
+                std::error_code error;
+                std::filesystem::remove(tempPath, error);
+            }
+        }
+
+        bool open(const std::string& outputPath) {
+            path = outputPath;
+            if (path == STANDARD_STREAM) {
+#ifdef _WIN32
+                // Keep '\n' as is, the output must match the file export byte for byte
+                _setmode(_fileno(stdout), _O_BINARY);
+#endif
+                file = stdout;
+                return true;
+            }
+
+            tempPath = path + ".tmp";
+            file = std::fopen(tempPath.c_str(), "wb");
+            if (!file) {
+                std::cerr << "Error writing file: " << tempPath << std::endl;
+                return false;
+            }
+            // Writers do their own buffering
+            std::setvbuf(file, nullptr, _IONBF, 0);
+            return true;
+        }
+
+        bool write(const char* data, size_t size) {
+            return std::fwrite(data, 1, size, file) == size;
+        }
+
+        Dat151Writer::Sink sink() {
+            return [this](const char* data, size_t size) { return write(data, size); };
+        }
+
+        bool commit() {
+            if (file == stdout) {
+                file = nullptr;
+                return std::fflush(stdout) == 0;
+            }
+
+            bool closed = std::fclose(file) == 0;
+            file = nullptr;
+            std::error_code error;
+            if (closed) {
+                std::filesystem::rename(tempPath, path, error);
+            }
+            if (!closed || error) {
+                std::cerr << "Error writing file: " << path << std::endl;
+                std::filesystem::remove(tempPath, error);
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        std::FILE* file = nullptr;
+        std::string path;
+        std::string tempPath;
+    };
+
+    /**
+     * Export JSON lines from stdin as they arrive
+     * Settings items are written as soon as their line is read; only the
+     * names are kept for the link items that follow them. A name that was
+     * already written cannot be replaced, so repeats are reported and skipped.
+     */
+    bool exportDoorLines(const PresetIndex& presets, Dat151Writer& writer, size_t& doorCount) {
+        std::deque<std::string> names;          // Element addresses stay valid on push_back
+        std::vector<uint32_t> hashes;
+        std::unordered_set<std::string_view> written;  // Views into names
+
+        writer.writeHeader();
+        bool valid = readDoorLines(std::cin, "<stdin>", presets, [&](Door& door) {
+            if (written.count(door.getName()) > 0) {
+                std::cerr << "<stdin>: skipping repeated door: " << door.getName() << std::endl;
+                return true;
+            }
+            writer.writeDoorAudioSettings(door);
+            names.push_back(door.getName());
+            hashes.push_back(joaat(names.back()));
+            written.insert(names.back());
+            return true;
+        });
+
+        for (size_t i = 0; i < names.size(); i++) {
+            writer.writeDoorAudioSettingsLink(names[i], hashes[i]);
+        }
+        writer.writeFooter();
+        doorCount = names.size();
+        return valid;
+    }
+
+    int runExport(int argc, char** argv) {
+        std::string settingsPath;
+        std::string outputPath;
+        std::string cacheDirectory;
+        std::vector<std::string> manifests;
+
+        for (int i = 2; i < argc; i++) {
+            if (std::strcmp(argv[i], "--settings") == 0 && i + 1 < argc) {
+                settingsPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+                cacheDirectory = argv[++i];
+            } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+                outputPath = argv[++i];
+            } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+                std::cerr << "Unknown option: " << argv[i] << std::endl;
+                printUsage(argv[0]);
+                return EXIT_USAGE;
+            } else {
+                manifests.push_back(argv[i]);
+            }
+        }
+
+        size_t stdinCount = std::count(manifests.begin(), manifests.end(), STANDARD_STREAM);
+        if (manifests.empty() || (!outputPath.empty() && manifests.size() > 1) || stdinCount > 1) {
+            printUsage(argv[0]);
+            return EXIT_USAGE;
+        }
+
+        // Presets are read once for every manifest of the run
+        std::vector<SoundPreset> presetList;
+        if (settingsPath.empty()) {
+            settingsPath = SettingsManager::getDefaultSettingsPath();
+        }
+        if (!SettingsManager::readPresetsFile(settingsPath, presetList)) {
+            return EXIT_FAILED;
+        }
+        PresetIndex presets(presetList);
+        ExportCache cache(cacheDirectory);
+
+        int exitCode = EXIT_OK;
+        for (const auto& manifest : manifests) {
+            auto start = std::chrono::steady_clock::now();
+            std::string output = outputPath.empty() ? defaultOutputPath(manifest) : outputPath;
+
+            // An unchanged manifest is recognized from its bytes, before anything is parsed
+            uint64_t fingerprint = 0;
+            bool isCached = false;
+            if (!cacheDirectory.empty() && manifest != STANDARD_STREAM && output != STANDARD_STREAM) {
+                MappedFile file;
+                if (file.open(manifest)) {
+                    fingerprint = fingerprintDat151Manifest(std::string_view(file.getData(), file.getSize()), presetList);
+                    isCached = true;
+                }
+            }
+            if (isCached && cache.isUpToDate(output, fingerprint)) {
+                std::cerr << output << ": up to date" << std::endl;
+                continue;
+            }
+
+            bool exported = false;
+            size_t doorCount = 0;
+            Output destination;
+            if (manifest == STANDARD_STREAM) {
+                if (destination.open(output)) {
+                    // Invalid lines fail the export, the valid doors still make a complete resource
+                    Dat151Writer writer(destination.sink());
+                    bool valid = exportDoorLines(presets, writer, doorCount);
+                    exported = writer.finish() && valid && destination.commit();
+                }
+            } else {
+                std::vector<Door> doors;
+                if (readDoorManifest(manifest, presets, doors) && destination.open(output)) {
+                    Dat151Writer writer(destination.sink());
+                    exported = writer.writeDoors(doors) && writer.finish() && destination.commit();
+                    doorCount = doors.size();
+                }
+                if (exported && isCached) {
+                    cache.store(output, fingerprint);
+                }
+            }
+
+            if (!exported) {
+                std::cerr << "Export failed: " << manifest << std::endl;
+                exitCode = EXIT_FAILED;
+                continue;
+            }
+
+            auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+            std::cerr << (output == STANDARD_STREAM ? "<stdout>" : output) << ": " << doorCount
+                      << " doors in " << elapsed.count() << " ms" << std::endl;
+        }
+        return exitCode;
+    }
+
+    int runImport(int argc, char** argv) {
+        std::string outputPath = STANDARD_STREAM;
+        std::vector<std::string> inputs;
+
+        for (int i = 2; i < argc; i++) {
+            if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+                outputPath = argv[++i];
+            } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+                std::cerr << "Unknown option: " << argv[i] << std::endl;
+                printUsage(argv[0]);
+                return EXIT_USAGE;
+            } else {
+                inputs.push_back(argv[i]);
+            }
+        }
+        if (inputs.empty() || std::count(inputs.begin(), inputs.end(), STANDARD_STREAM) > 1) {
+            printUsage(argv[0]);
+            return EXIT_USAGE;
+        }
+
+        Output destination;
+        if (!destination.open(outputPath)) {
+            return EXIT_FAILED;
+        }
+
+        // One JSON object per door, in the Door::toJson shape
+        const size_t FLUSH_SIZE = 64 * 1024;
+        std::string pending;
+        pending.reserve(FLUSH_SIZE * 2);
+        bool written = true;
+
+        int exitCode = EXIT_OK;
+        for (const auto& input : inputs) {
+            Dat151Reader reader;
+            bool opened = input == STANDARD_STREAM ? reader.open(std::cin) : reader.open(input);
+            if (!opened) {
+                std::cerr << "Import failed: " << input << std::endl;
+                exitCode = EXIT_FAILED;
+                continue;
+            }
+
+            size_t doorCount = 0;
+            reader.forEachDoor([&](const DoorRecordView& record) {
+                pending += record.toJson().dump();
+                pending += '\n';
+                doorCount++;
+
+                if (pending.size() >= FLUSH_SIZE) {
+                    written = destination.write(pending.data(), pending.size());
+                    pending.clear();
+                }
+                return written;
+            });
+            std::cerr << (input == STANDARD_STREAM ? "<stdin>" : input) << ": " << doorCount << " doors" << std::endl;
+        }
+
+        written = written && destination.write(pending.data(), pending.size()) && destination.commit();
+        if (!written) {
+            std::cerr << "Error writing output" << std::endl;
+            return EXIT_FAILED;
+        }
+        return exitCode;
+    }
+
+    int runServe(int argc, char** argv) {
+        std::string settingsPath;
+        std::string cacheDirectory;
+        std::string socketPath;
+
+        for (int i = 2; i < argc; i++) {
+            if (std::strcmp(argv[i], "--settings") == 0 && i + 1 < argc) {
+                settingsPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+                cacheDirectory = argv[++i];
+            } else if (argv[i][0] == '-' || !socketPath.empty()) {
+                printUsage(argv[0]);
+                return EXIT_USAGE;
+            } else {
+                socketPath = argv[i];
+            }
+        }
+        if (socketPath.empty()) {
+            printUsage(argv[0]);
+            return EXIT_USAGE;
+        }
+        if (settingsPath.empty()) {
+            settingsPath = SettingsManager::getDefaultSettingsPath();
+        }
+
+        DoorDaemon daemon(settingsPath, cacheDirectory);
+        if (!daemon.listen(socketPath)) {
+            return EXIT_FAILED;
+        }
+        daemon.run();
+        return EXIT_OK;
+    }
+
+    // Whole file or stdin, sent as a request payload
+    bool readInput(const std::string& path, std::string& contents) {
+        std::ifstream file;
+        std::istream* stream = &std::cin;
+        if (path != STANDARD_STREAM) {
+            file.open(path, std::ios::binary);
+            if (!file.is_open()) {
+                std::cerr << "Error opening file: " << path << std::endl;
+                return false;
+            }
+            stream = &file;
+        }
+        contents.assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        return !stream->bad();
+    }
+
+    std::string absolutePath(const std::string& path) {
+        std::error_code error;
+        std::filesystem::path absolute = std::filesystem::absolute(path, error);
+        return error ? path : absolute.lexically_normal().string();
+    }
+
+    struct DaemonRequest {
+        const char* name;
+        DoorDaemon::Request type;
+        int fileCount;
+        bool hasOutput;     // The response is the command's output rather than a count
+    };
+
+    const DaemonRequest DAEMON_REQUESTS[] = {
+        { "export", DoorDaemon::Request::Export, 1, true },
+        { "export-file", DoorDaemon::Request::ExportFile, 2, false },
+        { "import", DoorDaemon::Request::Import, 1, true },
+        { "validate", DoorDaemon::Request::Validate, 1, false },
+        { "shutdown", DoorDaemon::Request::Shutdown, 0, false },
+    };
+
+    int runRequest(int argc, char** argv) {
+        std::string outputPath = STANDARD_STREAM;
+        std::vector<std::string> arguments;
+
+        for (int i = 2; i < argc; i++) {
+            if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+                outputPath = argv[++i];
+            } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+                std::cerr << "Unknown option: " << argv[i] << std::endl;
+                printUsage(argv[0]);
+                return EXIT_USAGE;
+            } else {
+                arguments.push_back(argv[i]);
+            }
+        }
+
+        const DaemonRequest* request = nullptr;
+        if (arguments.size() >= 2) {
+            for (const auto& candidate : DAEMON_REQUESTS) {
+                if (arguments[1] == candidate.name) {
+                    request = &candidate;
+                }
+            }
+        }
+        if (!request || arguments.size() != 2 + static_cast<size_t>(request->fileCount)) {
+            printUsage(argv[0]);
+            return EXIT_USAGE;
+        }
+
+        std::string payload;
+        if (request->type == DoorDaemon::Request::ExportFile) {
+            payload = absolutePath(arguments[2]) + '\0' + absolutePath(arguments[3]);
+        } else if (request->fileCount == 1 && !readInput(arguments[2], payload)) {
+            return EXIT_FAILED;
+        }
+
+        int connection = connectDoorDaemon(arguments[0]);
+        if (connection < 0) {
+            std::cerr << "No daemon is listening on " << arguments[0] << std::endl;
+            return EXIT_FAILED;
+        }
+        uint8_t status = 0;
+        std::string response;
+        bool answered = writeDaemonFrame(connection, static_cast<uint8_t>(request->type), payload) &&
+                        readDaemonFrame(connection, status, response);
+        closeDoorDaemonConnection(connection);
+        if (!answered) {
+            std::cerr << "The daemon did not answer" << std::endl;
+            return EXIT_FAILED;
+        }
+
+        if (status != static_cast<uint8_t>(DoorDaemon::Status::Ok)) {
+            std::cerr << response;
+            return EXIT_FAILED;
+        }
+        if (!request->hasOutput) {
+            if (!response.empty()) {
+                std::cerr << response << " doors" << std::endl;
+            }
+            return EXIT_OK;
+        }
+
+        Output destination;
+        if (!destination.open(outputPath) || !destination.write(response.data(), response.size()) ||
+            !destination.commit()) {
+            std::cerr << "Error writing output" << std::endl;
+            return EXIT_FAILED;
+        }
+        return EXIT_OK;
+    }
+
+    struct Command {
+        const char* name;
+        int (*run)(int argc, char** argv);
+    };
+
+    const Command COMMANDS[] = {
+        { "export", runExport },
+        { "import", runImport },
+        { "serve", runServe },
+        { "request", runRequest },
+    };
+}
+
+bool isCliCommand(int argc, char** argv) {
+    if (argc < 2) {
+        return false;
+    }
+    for (const auto& command : COMMANDS) {
+        if (std::strcmp(argv[1], command.name) == 0) {
+            return true;
+        }
+    }
+    return std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "help") == 0;
+}
+
+int runCli(int argc, char** argv) {
+    if (argc >= 2) {
+        for (const auto& command : COMMANDS) {
+            if (std::strcmp(argv[1], command.name) == 0) {
+                return command.run(argc, argv);
+            }
+        }
+        if (std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "help") == 0) {
+            printUsage(argv[0]);
+            return EXIT_OK;
+        }
+        std::cerr << "Unknown command: " << argv[1] << std::endl;
+    }
+    printUsage(argv[0]);
+    return EXIT_USAGE;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * Check if the command line asks for a headless command
+ * @param argc Argument count from main
+ * @param argv Arguments from main
+ * @return true if argv[1] names a command, false to start the GUI
+ */
+bool isCliCommand(int argc, char** argv);
+
+/**
+ * Run a headless command without creating a window
+ * @param argc Argument count from main
+ * @param argv Arguments from main, argv[1] being the command
+ * @return Process exit code: 0 on success, 1 on failure, 2 on bad usage
+ */
+int runCli(int argc, char** argv);
@@ -0,0 +1,9 @@
+#include "cli.h"
+
+/**
+ * Headless entry point
+ * Same commands as the GUI executable, without linking GLFW or ImGui.
+ */
+int main(int argc, char** argv) {
+    return runCli(argc, argv);
+}
@@ -0,0 +1,83 @@
+#include "doorCardCache.h"
+#include <cstdio>
+#include <utility>
+
+DoorCardCache::DoorCardCache(DoorStore& store) : store(store), cards(store.size()) {
+    store.addListener(this);
+}
+
+DoorCardCache::~DoorCardCache() {
+    store.removeListener(this);
+}
+
+const DoorCardCache::Card& DoorCardCache::getCard(size_t index) {
+    if (cards.size() != store.size()) {
+        cards.resize(store.size());
+    }
+
+    Card& card = cards[index];
+    const Door& door = store[index];
+    char buffer[64];
+
+    if (!card.valid) {
+        card.soundsLine = "Sound: " + door.getSounds();
+        card.tuningLine = "Tuning: " + door.getTuningParams();
+        snprintf(buffer, sizeof(buffer), "Max Occlusion: %.2f", door.getMaxOcclusion());
+        card.occlusionLine = buffer;
+    }
+
+    // Doors shift when an earlier one is removed, so the number is checked separately
+    if (!card.valid || card.titleIndex != index) {
+        snprintf(buffer, sizeof(buffer), "%zu | ", index + 1);
+        card.title = buffer;
+        card.title += door.getName();
+        card.titleIndex = index;
+    }
+
+    card.valid = true;
+    return card;
+}
+
+void DoorCardCache::onDoorsInserted(const std::vector<size_t>& positions) {
+    // Appending is the common case (add, import)
+    if (!positions.empty() && positions.front() == cards.size()) {
+        cards.resize(cards.size() + positions.size());
+        return;
+    }
+
+    std::vector<Card> merged;
+    merged.reserve(cards.size() + positions.size());
+    size_t next = 0;
+    size_t old = 0;
+    while (merged.size() < cards.size() + positions.size()) {
+        if (next < positions.size() && positions[next] == merged.size()) {
+            merged.emplace_back();
+            next++;
+        } else {
+            merged.push_back(std::move(cards[old++]));
+        }
+    }
+    cards = std::move(merged);
+}
+
+void DoorCardCache::onDoorUpdated(size_t index, const Door&) {
+    if (index < cards.size()) {
+        cards[index].valid = false;
+    }
+}
+
+void DoorCardCache::onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>&) {
+    size_t write = 0;
+    size_t next = 0;
+    for (size_t read = 0; read < cards.size(); read++) {
+        if (next < positions.size() && positions[next] == read) {
+            next++;
+            continue;
+        }
+        if (write != read) {
+            cards[write] = std::move(cards[read]);
+        }
+        write++;
+    }
+    cards.resize(write);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../door_store.h"
+#include <string>
+#include <vector>
+
+// Formatted text of the door cards, rebuilt only when a door changes
+class DoorCardCache : public DoorStoreListener {
+public:
+    struct Card {
+        std::string title;        // "<number> | <name>"
+        std::string soundsLine;
+        std::string tuningLine;
+        std::string occlusionLine;
+        size_t titleIndex = 0;    // Index the title was formatted for
+        bool valid = false;
+    };
+
+    explicit DoorCardCache(DoorStore& store);
+    ~DoorCardCache() override;
+    DoorCardCache(const DoorCardCache&) = delete;
+    DoorCardCache& operator=(const DoorCardCache&) = delete;
+
+    // Up to date card for the door at index
+    const Card& getCard(size_t index);
+
+    void onDoorsInserted(const std::vector<size_t>& positions) override;
+    void onDoorUpdated(size_t index, const Door& previous) override;
+    void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) override;
+
+private:
+    DoorStore& store;
+    std::vector<Card> cards;
+};
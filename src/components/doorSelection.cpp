@@ -0,0 +1,85 @@
+#include "doorSelection.h"
+#include <algorithm>
+
+DoorSelection::DoorSelection(DoorStore& store) : store(store), flags(store.size(), 0) {
+    store.addListener(this);
+}
+
+DoorSelection::~DoorSelection() {
+    store.removeListener(this);
+}
+
+void DoorSelection::setSelected(size_t index, bool selected) {
+    if (index >= flags.size()) {
+        flags.resize(store.size(), 0);
+        if (index >= flags.size()) {
+            return;
+        }
+    }
+    if (static_cast<bool>(flags[index]) != selected) {
+        flags[index] = selected;
+        if (selected) {
+            selectedCount++;
+        } else {
+            selectedCount--;
+        }
+    }
+}
+
+void DoorSelection::clear() {
+    if (selectedCount > 0) {
+        std::fill(flags.begin(), flags.end(), 0);
+        selectedCount = 0;
+    }
+}
+
+std::vector<size_t> DoorSelection::getSelectedIndices() const {
+    std::vector<size_t> indices;
+    indices.reserve(selectedCount);
+    for (size_t i = 0; i < flags.size() && indices.size() < selectedCount; i++) {
+        if (flags[i]) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+void DoorSelection::onDoorsInserted(const std::vector<size_t>& positions) {
+    // New doors start unselected
+    if (!positions.empty() && positions.front() == flags.size()) {
+        flags.resize(flags.size() + positions.size(), 0);
+        return;
+    }
+    if (positions.empty()) {
+        return;
+    }
+
+    // Merge from the back so every flag moves once
+    size_t read = flags.size();
+    size_t next = positions.size();
+    flags.resize(flags.size() + positions.size(), 0);
+    for (size_t write = flags.size(); write-- > positions.front();) {
+        if (next > 0 && positions[next - 1] == write) {
+            flags[write] = 0;
+            next--;
+        } else {
+            flags[write] = flags[--read];
+        }
+    }
+}
+
+void DoorSelection::onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>&) {
+    size_t write = 0;
+    size_t next = 0;
+    for (size_t read = 0; read < flags.size(); read++) {
+        if (next < positions.size() && positions[next] == read) {
+            if (flags[read]) {
+                selectedCount--;
+            }
+            next++;
+            continue;
+        }
+        flags[write++] = flags[read];
+    }
+    flags.resize(write);
+}
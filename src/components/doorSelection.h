@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../door_store.h"
+#include <vector>
+
+// Set of selected doors, kept in sync with the store when doors move
+class DoorSelection : public DoorStoreListener {
+public:
+    explicit DoorSelection(DoorStore& store);
+    ~DoorSelection() override;
+    DoorSelection(const DoorSelection&) = delete;
+    DoorSelection& operator=(const DoorSelection&) = delete;
+
+    bool isSelected(size_t index) const { return index < flags.size() && flags[index]; }
+    void setSelected(size_t index, bool selected);
+    void clear();
+    size_t count() const { return selectedCount; }
+    bool empty() const { return selectedCount == 0; }
+
+    // Selected door indices, ascending
+    std::vector<size_t> getSelectedIndices() const;
+
+    void onDoorsInserted(const std::vector<size_t>& positions) override;
+    void onDoorUpdated(size_t, const Door&) override {}
+    void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) override;
+
+private:
+    DoorStore& store;
+    std::vector<char> flags;  // By door index
+    size_t selectedCount = 0;
+};
@@ -0,0 +1,194 @@
+#include "doorSortOrder.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+DoorSortOrder::DoorSortOrder(DoorStore& store) : store(store) {
+    store.addListener(this);
+}
+
+DoorSortOrder::~DoorSortOrder() {
+    store.removeListener(this);
+}
+
+void DoorSortOrder::setSort(Column newColumn, bool newAscending) {
+    if (column == newColumn && ascending == newAscending) {
+        return;
+    }
+    column = newColumn;
+    ascending = newAscending;
+    needsSort = true;
+}
+
+const std::vector<size_t>& DoorSortOrder::getOrder() {
+    // Re-sorting is cheaper than merging once most doors changed
+    if (!needsSort && pending.size() > order.size()) {
+        needsSort = true;
+    }
+    auto byColumn = [this](size_t a, size_t b) { return less(a, b); };
+
+    if (needsSort) {
+        order.resize(store.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), byColumn);
+        pending.clear();
+        needsSort = false;
+    } else if (!pending.empty()) {
+        std::sort(pending.begin(), pending.end());
+        pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+        // Take the changed doors out of their old place, then merge them back
+        std::vector<bool> isPending(store.size(), false);
+        for (size_t index : pending) {
+            isPending[index] = true;
+        }
+        order.erase(std::remove_if(order.begin(), order.end(), [&](size_t index) {
+            return isPending[index];
+        }), order.end());
+
+        std::sort(pending.begin(), pending.end(), byColumn);
+        size_t middle = order.size();
+        order.insert(order.end(), pending.begin(), pending.end());
+        std::inplace_merge(order.begin(), order.begin() + middle, order.end(), byColumn);
+        pending.clear();
+    } else {
+        return order;
+    }
+
+    ranksDirty = true;
+    version++;
+    return order;
+}
+
+size_t DoorSortOrder::getRank(size_t index) {
+    const auto& sorted = getOrder();
+    if (ranksDirty) {
+        ranks.resize(sorted.size());
+        for (size_t rank = 0; rank < sorted.size(); rank++) {
+            ranks[sorted[rank]] = rank;
+        }
+        ranksDirty = false;
+    }
+    return ranks[index];
+}
+
+void DoorSortOrder::onDoorsInserted(const std::vector<size_t>& positions) {
+    if (positions.empty() || needsSort) {
+        needsSort = true;
+        return;
+    }
+
+    // Inserting before existing doors shifts their indices
+    size_t oldSize = store.size() - positions.size();
+    if (positions.front() < oldSize) {
+        std::vector<size_t> newIndices(oldSize);
+        size_t next = 0;
+        size_t old = 0;
+        for (size_t index = 0; index < store.size(); index++) {
+            if (next < positions.size() && positions[next] == index) {
+                next++;
+            } else {
+                newIndices[old++] = index;
+            }
+        }
+        remap(newIndices);
+    }
+    pending.insert(pending.end(), positions.begin(), positions.end());
+}
+
+void DoorSortOrder::onDoorUpdated(size_t index, const Door&) {
+    if (needsSort) {
+        return;
+    }
+    pending.push_back(index);
+
+    // The order may not be read for a while, e.g. in card view
+    if (pending.size() > store.size()) {
+        pending.clear();
+        needsSort = true;
+    }
+}
+
+void DoorSortOrder::onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>&) {
+    if (positions.empty() || needsSort) {
+        needsSort = true;
+        return;
+    }
+
+    size_t oldSize = store.size() + positions.size();
+    std::vector<size_t> newIndices(oldSize);
+    size_t next = 0;
+    size_t removed = 0;
+    for (size_t index = 0; index < oldSize; index++) {
+        if (next < positions.size() && positions[next] == index) {
+            newIndices[index] = DoorStore::npos;
+            next++;
+            removed++;
+        } else {
+            newIndices[index] = index - removed;
+        }
+    }
+    remap(newIndices);
+
+    // Removing doors keeps the relative order of the others
+    ranksDirty = true;
+    version++;
+}
+
+bool DoorSortOrder::less(size_t a, size_t b) const {
+    const Door& left = store[ascending ? a : b];
+    const Door& right = store[ascending ? b : a];
+
+    int compare = 0;
+    switch (column) {
+        case Column::Index:
+            break;
+        case Column::Name:
+            compare = left.getName().compare(right.getName());
+            break;
+        case Column::Sounds:
+            if (left.getInternedSounds() != right.getInternedSounds()) {
+                compare = left.getSounds().compare(right.getSounds());
+            }
+            break;
+        case Column::TuningParams:
+            if (left.getInternedTuningParams() != right.getInternedTuningParams()) {
+                compare = left.getTuningParams().compare(right.getTuningParams());
+            }
+            break;
+        case Column::MaxOcclusion: {
+            // NaN sorts above every number, comparisons with it would break the ordering
+            float leftValue = left.getMaxOcclusion();
+            float rightValue = right.getMaxOcclusion();
+            bool isLeftNan = std::isnan(leftValue);
+            bool isRightNan = std::isnan(rightValue);
+            if (isLeftNan || isRightNan) {
+                compare = isLeftNan == isRightNan ? 0 : (isLeftNan ? 1 : -1);
+            } else if (leftValue != rightValue) {
+                compare = leftValue < rightValue ? -1 : 1;
+            }
+            break;
+        }
+    }
+
+    // Ties fall back to insertion order so every door has a single place
+    if (compare == 0) {
+        return ascending ? a < b : a > b;
+    }
+    return compare < 0;
+}
+
+void DoorSortOrder::remap(const std::vector<size_t>& newIndices) {
+    auto apply = [&](std::vector<size_t>& indices) {
+        size_t write = 0;
+        for (size_t index : indices) {
+            size_t mapped = newIndices[index];
+            if (mapped != DoorStore::npos) {
+                indices[write++] = mapped;
+            }
+        }
+        indices.resize(write);
+    };
+    apply(order);
+    apply(pending);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../door_store.h"
+#include <cstdint>
+#include <vector>
+
+// Door indices ordered by a column, kept up to date without re-sorting the
+// whole list on every change. Changed doors are collected and merged back
+// into the order the next time it is read.
+class DoorSortOrder : public DoorStoreListener {
+public:
+    enum class Column {
+        Index,  // Insertion order
+        Name,
+        Sounds,
+        TuningParams,
+        MaxOcclusion
+    };
+
+    explicit DoorSortOrder(DoorStore& store);
+    ~DoorSortOrder() override;
+    DoorSortOrder(const DoorSortOrder&) = delete;
+    DoorSortOrder& operator=(const DoorSortOrder&) = delete;
+
+    void setSort(Column column, bool ascending);
+
+    // Door indices in display order
+    const std::vector<size_t>& getOrder();
+
+    // Position of a door in the display order
+    size_t getRank(size_t index);
+
+    // Incremented whenever the order changes
+    uint64_t getVersion() const { return version; }
+
+    void onDoorsInserted(const std::vector<size_t>& positions) override;
+    void onDoorUpdated(size_t index, const Door& previous) override;
+    void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) override;
+
+private:
+    bool less(size_t a, size_t b) const;
+    void remap(const std::vector<size_t>& newIndices);
+
+    DoorStore& store;
+    Column column = Column::Index;
+    bool ascending = true;
+
+    std::vector<size_t> order;
+    std::vector<size_t> pending;  // Doors added or changed since the order was last merged
+    bool needsSort = true;
+
+    std::vector<size_t> ranks;    // Door index -> position in order
+    bool ranksDirty = true;
+    uint64_t version = 0;
+};
@@ -3,6 +3,7 @@
 #include "imgui.h"
 #include "../settings_manager.h"
 #include "../doors.h"
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -11,17 +12,19 @@ class DoorWindow {
 public:
     DoorWindow();
     void render();
-    void open() { isOpen = true; }
+    void open() { isOpen = true; validationDirty = true; }
     void openForEdit(const Door& door, size_t index);
     void setOnDoorAdded(std::function<void(const Door&)> callback) { onDoorAdded = callback; }
     void setOnDoorEdited(std::function<void(const Door&, size_t)> callback) { onDoorEdited = callback; }
     void setOnCheckDoorExists(std::function<bool(const char*, int)> callback) { onCheckDoorExists = callback; }
     bool isModalOpen() const { return isOpen; }
-    std::function<std::vector<Door>()> onGetDoors;
-    void generateXmlFile(const std::string& filePath);
+    // Revision of the door list, the name check is redone when it changes
+    void setDoorsRevision(uint64_t revision) { doorsRevision = revision; }
 
 private:
     void resetForm();
+    void validateName();
+    static int onNameEdited(ImGuiInputTextCallbackData* data);
     bool isOpen = false;
     bool isEditing = false;
     size_t editingIndex = 0;
@@ -36,5 +39,10 @@ private:
     float maxOcclusion;
     size_t selectedPreset;
 
-    std::string calculateJoaatHash(const char* str);
+    // Cached name validation, recomputed only when the name or the door list changes
+    bool validationDirty = true;
+    uint64_t doorsRevision = 0;
+    uint64_t validatedRevision = 0;
+    bool nameEmpty = true;
+    bool nameExists = false;
 }; 
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "generateWindow.h"
+#include "../door_generator.h"
+#include <cstring>
+#include <imgui.h>
+
+GenerateWindow::GenerateWindow() {
+    strcpy(pattern, "door_name_##");
+}
+
+void GenerateWindow::render() {
+    if (!isOpen) return;
+
+    ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Generate Doors", &isOpen,
+        ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse)) {
+
+        ImGui::Text("Name Pattern (# is replaced by the number):");
+        if (ImGui::InputText("Pattern", pattern, IM_ARRAYSIZE(pattern))) {
+            previewDirty = true;
+        }
+        if (ImGui::InputInt("First Number", &firstNumber)) {
+            firstNumber = firstNumber < 0 ? 0 : firstNumber;
+            previewDirty = true;
+        }
+        if (ImGui::InputInt("Count", &doorCount, 1, 100)) {
+            doorCount = doorCount < 1 ? 1 : (doorCount > MAX_DOOR_COUNT ? MAX_DOOR_COUNT : doorCount);
+            previewDirty = true;
+        }
+        if (previewDirty) {
+            updatePreview();
+        }
+
+        if (!patternValid) {
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "The pattern needs a '#' for the door number");
+        } else {
+            ImGui::TextUnformatted(previewText.c_str());
+        }
+
+        ImGui::Spacing();
+        ImGui::Text("Sound Preset:");
+        const auto& presets = SettingsManager::getInstance().getSoundPresets();
+        if (selectedPreset >= presets.size()) {
+            selectedPreset = 0;
+        }
+        if (ImGui::BeginCombo("Presets", presets.empty() ? "No presets" : presets[selectedPreset].name.c_str())) {
+            for (size_t i = 0; i < presets.size(); i++) {
+                bool is_selected = (selectedPreset == i);
+                if (ImGui::Selectable(presets[i].name.c_str(), is_selected)) {
+                    selectedPreset = i;
+                }
+                if (is_selected) {
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        ImGui::Spacing();
+        bool canGenerate = patternValid && !presets.empty() && !isLocked;
+        if (!canGenerate) {
+            ImGui::BeginDisabled();
+        }
+        if (ImGui::Button("Generate", ImVec2(100, 20))) {
+            std::vector<Door> doors;
+            if (generateDoors(pattern, static_cast<uint32_t>(firstNumber), static_cast<uint32_t>(doorCount),
+                              presets[selectedPreset], doors) && onDoorsGenerated) {
+                size_t added = onDoorsGenerated(std::move(doors));
+                resultText = "Added " + std::to_string(added) + " doors";
+                if (added < static_cast<size_t>(doorCount)) {
+                    resultText += ", " + std::to_string(doorCount - added) + " already existed";
+                }
+            }
+        }
+        if (!canGenerate) {
+            ImGui::EndDisabled();
+        }
+        if (!resultText.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(resultText.c_str());
+        }
+
+        ImGui::End();
+    }
+}
+
+void GenerateWindow::updatePreview() {
+    patternValid = isValidDoorPattern(pattern);
+    if (patternValid) {
+        uint32_t first = static_cast<uint32_t>(firstNumber);
+        uint32_t last = first + static_cast<uint32_t>(doorCount) - 1;
+        previewText = formatDoorPatternName(pattern, first);
+        if (doorCount > 1) {
+            previewText += " ... " + formatDoorPatternName(pattern, last);
+        }
+    }
+    previewDirty = false;
+}
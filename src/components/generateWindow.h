@@ -0,0 +1,43 @@
+#pragma once
+
+#include "imgui.h"
+#include "../settings_manager.h"
+#include "../doors.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Creates a numbered series of doors from a name pattern and a preset
+class GenerateWindow {
+public:
+    GenerateWindow();
+    void render();
+    void open() { isOpen = true; resultText.clear(); }
+    // Receives the generated doors, returns how many were actually added
+    void setOnDoorsGenerated(std::function<size_t(std::vector<Door>)> callback) { onDoorsGenerated = callback; }
+    bool isWindowOpen() const { return isOpen; }
+    // Doors cannot be generated while an import is being committed
+    void setLocked(bool locked) { isLocked = locked; }
+
+    // Largest series generated at once
+    static constexpr int MAX_DOOR_COUNT = 100000;
+
+private:
+    void updatePreview();
+
+    bool isOpen = false;
+    bool isLocked = false;
+    std::function<size_t(std::vector<Door>)> onDoorsGenerated;
+
+    // Form variables
+    char pattern[256];
+    int firstNumber = 1;
+    int doorCount = 10;
+    size_t selectedPreset = 0;
+
+    // Cached preview, rebuilt when the form changes
+    bool previewDirty = true;
+    bool patternValid = false;
+    std::string previewText;
+    std::string resultText;
+};
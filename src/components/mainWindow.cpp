@@ -1,9 +1,15 @@
 #include "mainWindow.h"
-#include <iostream>
+#include "../dat151.h"
 #include "../libs/ImGuiFileDialog/ImGuiFileDialog.h"
-#include <pugixml.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
 
 MainWindow::MainWindow() {
+    selectionStorage.UserData = this;
+    selectionStorage.AdapterSetItemSelected = &MainWindow::onSetItemSelected;
+
     doorWindow.setOnDoorAdded([this](const Door& door) {
         handleDoorAdded(door);
     });
@@ -13,84 +19,199 @@ MainWindow::MainWindow() {
     doorWindow.setOnCheckDoorExists([this](const char* name, int currentIndex) {
         return checkDoorExists(name, currentIndex);
     });
-    doorWindow.onGetDoors = [this]() {
-        return doors;
-    };
+    generateWindow.setOnDoorsGenerated([this](std::vector<Door> generated) {
+        return handleDoorsGenerated(std::move(generated));
+    });
+}
+
+void MainWindow::setOnRequestRedraw(std::function<void()> callback) {
+    importJob.setOnProgress(callback);
+    exportJob.setOnProgress(callback);
+}
+
+bool MainWindow::hasBackgroundWork() {
+    // Running jobs need frames to commit batches and update their progress bars
+    return importJob.isRunning() || exportJob.isRunning();
 }
 
 void MainWindow::handleDoorAdded(const Door& door) {
-    doors.push_back(door);
+    history.beginOperation("Add door");
+    doors.addDoor(door);
+    history.endOperation();
 }
 
 void MainWindow::handleDoorEdited(const Door& door, size_t index) {
-    if (index < doors.size()) {
-        doors[index] = door;
-    }
+    history.beginOperation("Edit door");
+    doors.updateDoor(index, door);
+    history.endOperation();
+}
+
+size_t MainWindow::handleDoorsGenerated(std::vector<Door> generated) {
+    // Existing doors keep their settings, only new names are added
+    generated.erase(std::remove_if(generated.begin(), generated.end(), [this](const Door& door) {
+        return doors.hasDoor(door.getName());
+    }), generated.end());
+    size_t added = generated.size();
+    history.beginOperation("Generate doors");
+    doors.addDoors(std::move(generated));
+    history.endOperation();
+    return added;
 }
 
 void MainWindow::deleteDoor(size_t index) {
-    if (index < doors.size()) {
-        doors.erase(doors.begin() + index);
+    // Deferred so the lists being drawn keep valid indices until the frame ends
+    pendingDeletes.push_back(index);
+}
+
+void MainWindow::flushDeletes() {
+    if (!pendingDeletes.empty()) {
+        history.beginOperation("Delete doors");
+        doors.removeDoors(std::move(pendingDeletes));
+        history.endOperation();
+        pendingDeletes.clear();
     }
 }
 
 bool MainWindow::checkDoorExists(const char* name, int currentIndex) {
-    for (size_t i = 0; i < doors.size(); i++) {
-        // Ignorer la porte en cours d'édition
-        if (i == currentIndex) continue;
-        
-        if (doors[i].getName() == name) {
-            return true;
-        }
-    }
-    return false;
+    // Ignorer la porte en cours d'édition
+    size_t ignoredIndex = currentIndex < 0 ? DoorStore::npos : static_cast<size_t>(currentIndex);
+    return doors.hasDoor(name, ignoredIndex);
 }
 
-void MainWindow::importXmlFile(const std::string& filePath) {
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_file(filePath.c_str());
+void MainWindow::importFile(const std::string& filePath) {
+    // The file is parsed off-thread, batches are committed by commitImportBatches
+    // The whole import is one operation, which is also how a cancelled import is rolled back
+    if (importJob.start(filePath, PresetIndex(SettingsManager::getInstance().getSoundPresets()))) {
+        history.beginOperation("Import");
+        isImportRecorded = true;
+    }
+}
 
-    if (!result) {
-        std::cerr << "Error loading XML file: " << result.description() << std::endl;
-        return;
+void MainWindow::commitImportBatches() {
+    // Commit for a few milliseconds per frame so rendering stays smooth
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(4);
+    std::vector<Door> batch;
+    std::vector<Door> added;
+    std::unordered_map<std::string_view, size_t> addedByName;  // Views into batch
+    while (importJob.takeBatch(batch)) {
+        added.clear();
+        addedByName.clear();
+        for (const auto& door : batch) {
+            // Check if a door with this name already exists
+            size_t index = doors.findDoor(door.getName());
+            if (index != DoorStore::npos) {
+                doors.updateDoor(index, door); // Replace existing door
+                continue;
+            }
+            auto [it, isNew] = addedByName.emplace(door.getName(), added.size());
+            if (isNew) {
+                added.push_back(door);
+            } else {
+                added[it->second] = door; // Repeated in the batch, the last one wins
+            }
+        }
+        // New doors of the batch are appended at once
+        doors.addDoors(std::move(added));
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
     }
 
-    auto dat151Node = doc.child("Dat151");
-    if (!dat151Node) {
-        std::cerr << "No 'Dat151' node found in XML file" << std::endl;
-        return;
+    // Completed or failed, whatever was committed can be undone as a whole
+    if (isImportRecorded && !importJob.isRunning()) {
+        history.endOperation();
+        isImportRecorded = false;
     }
+}
 
-    auto itemsNode = dat151Node.child("Items");
-    if (!itemsNode) {
-        std::cerr << "No 'Items' node found in XML file" << std::endl;
-        return;
+void MainWindow::rollbackImport() {
+    if (isImportRecorded) {
+        history.cancelOperation();
+        isImportRecorded = false;
     }
+}
 
-    for (auto itemNode : itemsNode.children("Item")) {
-        if (std::string(itemNode.attribute("type").as_string()) == "DoorAudioSettings") {
-            Door door;
-            std::string name = itemNode.child("Name").text().as_string();
-            // Remove 'd_' prefix if it exists
-            if (name.substr(0, 2) == "d_") {
-                name = name.substr(2);
+void MainWindow::renderImportStatus() {
+    ImGui::PushID("ImportStatus");
+    switch (importJob.getStatus()) {
+        case ImportJob::Status::Running: {
+            size_t total = importJob.getTotalBytes();
+            float fraction = total > 0 ? static_cast<float>(importJob.getBytesProcessed()) / static_cast<float>(total) : 0.0f;
+            char overlay[128];
+            snprintf(overlay, sizeof(overlay), "%.1f / %.1f MB, %zu doors",
+                     importJob.getBytesProcessed() / 1048576.0, total / 1048576.0, importJob.getDoorsParsed());
+            ImGui::ProgressBar(fraction, ImVec2(372, 20), overlay);
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel", ImVec2(100, 20))) {
+                importJob.cancel();
+                rollbackImport();
             }
-            door.setName(name);
-            door.setSounds(itemNode.child("Sounds").text().as_string());
-            door.setTuningParams(itemNode.child("TuningParams").text().as_string());
-            door.setMaxOcclusion(itemNode.child("MaxOcclusion").attribute("value").as_float());
-
-            // Check if a door with this name already exists
-            auto it = std::find_if(doors.begin(), doors.end(), [&](const Door& d) {
-                return d.getName() == name;
-            });
-            if (it != doors.end()) {
-                *it = door; // Replace existing door
+            break;
+        }
+        case ImportJob::Status::Completed:
+            if (importJob.getRowsSkipped() > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Imported %zu doors, skipped %zu invalid rows",
+                                   importJob.getDoorsParsed(), importJob.getRowsSkipped());
+                ImGui::SetItemTooltip("The skipped rows are listed in the console");
             } else {
-                doors.push_back(door); // Add new door
+                ImGui::Text("Imported %zu doors", importJob.getDoorsParsed());
+            }
+            break;
+        case ImportJob::Status::Failed:
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Import failed. Check the console for details.");
+            break;
+        case ImportJob::Status::Cancelled:
+            ImGui::Text("Import cancelled, changes were rolled back");
+            break;
+        case ImportJob::Status::Idle:
+            break;
+    }
+
+    if (!importJob.isRunning()) {
+        ImGui::SameLine(ImGui::GetWindowWidth() - 110);
+        if (ImGui::Button("Dismiss", ImVec2(100, 20))) {
+            importJob.reset();
+        }
+    }
+    ImGui::PopID();
+}
+
+void MainWindow::renderExportStatus() {
+    ImGui::PushID("ExportStatus");
+    switch (exportJob.getStatus()) {
+        case ExportJob::Status::Running: {
+            size_t total = exportJob.getTotalItems();
+            float fraction = total > 0 ? static_cast<float>(exportJob.getItemsWritten()) / static_cast<float>(total) : 0.0f;
+            char overlay[128];
+            snprintf(overlay, sizeof(overlay), "%zu / %zu items (%.0f items/s)",
+                     exportJob.getItemsWritten(), total, exportJob.getItemsPerSecond());
+            ImGui::ProgressBar(fraction, ImVec2(372, 20), overlay);
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel", ImVec2(100, 20))) {
+                exportJob.cancel();
             }
+            break;
         }
+        case ExportJob::Status::Completed:
+            ImGui::Text("Exported %zu items (%.0f items/s)", exportJob.getItemsWritten(), exportJob.getItemsPerSecond());
+            break;
+        case ExportJob::Status::Failed:
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Export failed. Check the console for details.");
+            break;
+        case ExportJob::Status::Cancelled:
+            ImGui::Text("Export cancelled, the existing file was kept");
+            break;
+        case ExportJob::Status::Idle:
+            break;
     }
+
+    if (!exportJob.isRunning()) {
+        ImGui::SameLine(ImGui::GetWindowWidth() - 110);
+        if (ImGui::Button("Dismiss", ImVec2(100, 20))) {
+            exportJob.reset();
+        }
+    }
+    ImGui::PopID();
 }
 
 void MainWindow::render() {
@@ -99,15 +220,36 @@ void MainWindow::render() {
     ImGui::Begin("GTA V Audio Door Tool", nullptr, 
         ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
 
+    commitImportBatches();
+
+    // Doors cannot be added, edited or deleted while an import is being committed
+    bool isImporting = importJob.isRunning();
+    bool isModalOpen = doorWindow.isModalOpen();
+
     // Top navigation buttons
+    if (isImporting || isModalOpen) {
+        ImGui::BeginDisabled();
+    }
+    // A cancelled import may still be winding down in the background
+    ImGui::BeginDisabled(!importJob.canStart());
     if (ImGui::Button("Import file", ImVec2(100, 20))) {
         IGFD::FileDialogConfig config;
         config.countSelectionMax = 1;
         config.flags = ImGuiFileDialogFlags_Modal;
         config.path = ".";
         config.fileName = "";
-        ImGuiFileDialog::Instance()->OpenDialog("ChooseImportFile", "Choose File to Import", ".xml", config);
+        ImGuiFileDialog::Instance()->OpenDialog("ChooseImportFile", "Choose File to Import", ".xml,.csv,.tsv,.txt", config);
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Generate doors", ImVec2(110, 20))) {
+        generateWindow.open();
     }
+    if (isImporting || isModalOpen) {
+        ImGui::EndDisabled();
+    }
+
+    renderHistoryButtons();
 
     ImGui::SameLine(ImGui::GetWindowWidth() - 110);
     if (ImGui::Button("Settings", ImVec2(100, 20))) {
@@ -115,47 +257,52 @@ void MainWindow::render() {
         ImGui::OpenPopup("Settings");
     }
 
-    // Scrollable area for door cards
-    ImGui::BeginChild("Doors", ImVec2(482, 480), true);
-
-    bool isModalOpen = doorWindow.isModalOpen();
-    for (size_t i = 0; i < doors.size(); i++) {
-        const auto& door = doors[i];
-        ImGui::BeginChild(("DoorCard" + std::to_string(i)).c_str(), ImVec2(450, 90), true);
-
-        ImGui::BeginGroup();
-        char buffer[256];
-        snprintf(buffer, sizeof(buffer), "%zu | %s", i + 1, door.getName().c_str());
-        ImGui::Text("%s", buffer);
-        ImGui::EndGroup();
-
-        float bouton_width_total = 120;
-        float padding = 10.0f;
-        ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - bouton_width_total - padding);
-
-        if (isModalOpen) ImGui::BeginDisabled();
-        if (ImGui::Button("Edit", ImVec2(60, 20))) {
-            doorWindow.openForEdit(door, i);
-        }
-        if (isModalOpen) ImGui::EndDisabled();
-
+    // Filter by name, sounds or tuning parameters
+    ImGui::SetNextItemWidth(360);
+    ImGui::InputTextWithHint("##Filter", "Filter by name, sounds or tuning", filterText, IM_ARRAYSIZE(filterText),
+        ImGuiInputTextFlags_CallbackEdit, &MainWindow::onFilterEdited, this);
+    bool isFiltering = filterText[0] != '\0';
+    if (isFiltering) {
+        updateFilter();
         ImGui::SameLine();
-        if (ImGui::Button("Delete", ImVec2(60, 20))) {
-            deleteDoor(i);
-        }
+        ImGui::Text("%zu / %zu", filteredDoors.size(), doors.size());
+    }
+    ImGui::SameLine(ImGui::GetWindowWidth() - 110);
+    if (ImGui::Button(showTable ? "Card view" : "Table view", ImVec2(100, 20))) {
+        showTable = !showTable;
+    }
 
-        ImGui::Text("Sound: %s", door.getSounds().c_str());
-        ImGui::Text("Tuning: %s", door.getTuningParams().c_str());
-        ImGui::Text("Max Occlusion: %.2f", door.getMaxOcclusion());
+    // Bulk actions on the table selection
+    bool showBulkActions = showTable && !selection.empty();
+    if (showBulkActions) {
+        renderBulkActions();
+    }
 
-        ImGui::EndChild();
+    // Scrollable door list, shortened while job status rows are shown
+    bool showImportStatus = importJob.getStatus() != ImportJob::Status::Idle;
+    bool showExportStatus = exportJob.getStatus() != ExportJob::Status::Idle;
+    int statusRows = 1 + (showBulkActions ? 2 : 0) + (showImportStatus ? 1 : 0) + (showExportStatus ? 1 : 0);
+    float doorsHeight = 480.0f - statusRows * ImGui::GetFrameHeightWithSpacing();
+    if (showTable) {
+        renderDoorTable(doorsHeight, isFiltering);
+    } else {
+        renderDoorCards(doorsHeight, isFiltering);
     }
 
-    ImGui::EndChild();
+    if (showImportStatus) {
+        renderImportStatus();
+    }
+    if (showExportStatus) {
+        renderExportStatus();
+    }
 
     // Bottom action buttons
     ImGui::Columns(3, nullptr, false);
     // Column 1: left button
+    bool isExporting = exportJob.isRunning();
+    if (isExporting || isImporting) {
+        ImGui::BeginDisabled();
+    }
     if (ImGui::Button("Generate file", ImVec2(100, 20))) {
         IGFD::FileDialogConfig config;
         config.countSelectionMax = 1;
@@ -164,6 +311,9 @@ void MainWindow::render() {
         config.fileName = "door_game.dat151.rel.xml";
         ImGuiFileDialog::Instance()->OpenDialog("ChooseFile", "Choose File", ".xml", config);
     }
+    if (isExporting || isImporting) {
+        ImGui::EndDisabled();
+    }
     ImGui::NextColumn();
     // Column 2: centered text
     float textWidth = ImGui::CalcTextSize("made by tiwabs").x;
@@ -173,7 +323,7 @@ void MainWindow::render() {
     ImGui::Text("made by tiwabs");
     ImGui::NextColumn();
     // Column 3: right button
-    if (isModalOpen) {
+    if (isModalOpen || isImporting) {
         ImGui::BeginDisabled();
     }
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 50);
@@ -181,7 +331,7 @@ void MainWindow::render() {
         doorWindow.open();
         ImGui::OpenPopup("Add New Door");
     }
-    if (isModalOpen) {
+    if (isModalOpen || isImporting) {
         ImGui::EndDisabled();
     }
     ImGui::Columns(1);
@@ -190,7 +340,8 @@ void MainWindow::render() {
     if (ImGuiFileDialog::Instance()->Display("ChooseFile")) {
         if (ImGuiFileDialog::Instance()->IsOk()) {
             std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-            doorWindow.generateXmlFile(filePath);
+            // Export a snapshot so the list stays editable while the file is written
+            exportJob.start(doors.getDoors(), filePath);
         }
         ImGuiFileDialog::Instance()->Close();
     }
@@ -198,14 +349,320 @@ void MainWindow::render() {
     if (ImGuiFileDialog::Instance()->Display("ChooseImportFile")) {
         if (ImGuiFileDialog::Instance()->IsOk()) {
             std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-            importXmlFile(filePath);
+            importFile(filePath);
         }
         ImGuiFileDialog::Instance()->Close();
     }
 
     // Render modals
     settingsWindow.render();
+    doorWindow.setDoorsRevision(doors.getRevision());
     doorWindow.render();
+    generateWindow.setLocked(importJob.isRunning());
+    generateWindow.render();
 
     ImGui::End();
-} 
\ No newline at end of file
+
+    // Deletions requested during the frame are applied together
+    flushDeletes();
+}
+
+void MainWindow::updateFilter() {
+    if (!filterDirty && filterRevision == doors.getRevision()) {
+        return;
+    }
+    doorSearch.search(filterText, filteredDoors);
+    filterVersion++;
+    filterDirty = false;
+    filterRevision = doors.getRevision();
+}
+
+int MainWindow::onFilterEdited(ImGuiInputTextCallbackData* data) {
+    static_cast<MainWindow*>(data->UserData)->filterDirty = true;
+    return 0;
+}
+
+void MainWindow::renderDoorCards(float height, bool isFiltering) {
+    bool isImporting = importJob.isRunning();
+    bool isModalOpen = doorWindow.isModalOpen();
+    ImGui::BeginChild("Doors", ImVec2(482, height), true);
+
+    // Only the visible cards are submitted; the clipper skips the rest
+    const float cardHeight = 90.0f;
+    size_t rowCount = isFiltering ? filteredDoors.size() : doors.size();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rowCount), cardHeight + ImGui::GetStyle().ItemSpacing.y);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            size_t i = isFiltering ? filteredDoors[row] : static_cast<size_t>(row);
+            const auto& card = doorCards.getCard(i);
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::BeginChild("DoorCard", ImVec2(450, cardHeight), true);
+
+            ImGui::BeginGroup();
+            ImGui::TextUnformatted(card.title.c_str(), card.title.c_str() + card.title.size());
+            ImGui::EndGroup();
+
+            float bouton_width_total = 120;
+            float padding = 10.0f;
+            ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - bouton_width_total - padding);
+
+            if (isModalOpen || isImporting) ImGui::BeginDisabled();
+            if (ImGui::Button("Edit", ImVec2(60, 20))) {
+                doorWindow.openForEdit(doors[i], i);
+            }
+            if (isModalOpen || isImporting) ImGui::EndDisabled();
+
+            ImGui::SameLine();
+            if (isModalOpen || isImporting) ImGui::BeginDisabled();
+            if (ImGui::Button("Delete", ImVec2(60, 20))) {
+                deleteDoor(i);
+            }
+            if (isModalOpen || isImporting) ImGui::EndDisabled();
+
+            ImGui::TextUnformatted(card.soundsLine.c_str(), card.soundsLine.c_str() + card.soundsLine.size());
+            ImGui::TextUnformatted(card.tuningLine.c_str(), card.tuningLine.c_str() + card.tuningLine.size());
+            ImGui::TextUnformatted(card.occlusionLine.c_str(), card.occlusionLine.c_str() + card.occlusionLine.size());
+
+            ImGui::EndChild();
+            ImGui::PopID();
+        }
+    }
+    clipper.End();
+
+    ImGui::EndChild();
+}
+
+
+void MainWindow::renderDoorTable(float height, bool isFiltering) {
+    bool isImporting = importJob.isRunning();
+    bool isModalOpen = doorWindow.isModalOpen();
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate | ImGuiTableFlags_ScrollY |
+                            ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("DoorTable", 5, flags, ImVec2(482, height))) {
+        return;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 0.0f, static_cast<ImGuiID>(DoorSortOrder::Column::Name));
+    ImGui::TableSetupColumn("Sounds", ImGuiTableColumnFlags_WidthStretch, 0.0f, static_cast<ImGuiID>(DoorSortOrder::Column::Sounds));
+    ImGui::TableSetupColumn("Tuning", ImGuiTableColumnFlags_WidthStretch, 0.0f, static_cast<ImGuiID>(DoorSortOrder::Column::TuningParams));
+    ImGui::TableSetupColumn("Occl.", ImGuiTableColumnFlags_WidthFixed, 40.0f, static_cast<ImGuiID>(DoorSortOrder::Column::MaxOcclusion));
+    ImGui::TableSetupColumn("##Actions", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort, 90.0f);
+    ImGui::TableHeadersRow();
+
+    // Only re-sorted when the user changes the sort, the order is kept up to date otherwise
+    if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs()) {
+        if (sortSpecs->SpecsDirty) {
+            if (sortSpecs->SpecsCount > 0) {
+                const auto& spec = sortSpecs->Specs[0];
+                doorOrder.setSort(static_cast<DoorSortOrder::Column>(spec.ColumnUserID),
+                                  spec.SortDirection == ImGuiSortDirection_Ascending);
+            } else {
+                doorOrder.setSort(DoorSortOrder::Column::Index, true);
+            }
+            sortSpecs->SpecsDirty = false;
+        }
+    }
+
+    const std::vector<size_t>& rows = isFiltering ? getSortedFilter() : doorOrder.getOrder();
+
+    // Ctrl+A selects every visible row, so the filter can narrow what gets selected
+    // ImGui only knows about the visible rows, so it is given their selected count
+    size_t visibleSelected = selection.count();
+    if (isFiltering && !selection.empty()) {
+        visibleSelected = 0;
+        for (size_t index : rows) {
+            visibleSelected += selection.isSelected(index);
+        }
+    }
+    selectionRows = &rows;
+    ImGuiMultiSelectFlags selectFlags = ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_BoxSelect1d;
+    ImGuiMultiSelectIO* selectIO = ImGui::BeginMultiSelect(selectFlags, static_cast<int>(visibleSelected),
+                                                           static_cast<int>(rows.size()));
+    applySelectionRequests(selectIO);
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+    if (selectIO->RangeSrcItem != -1) {
+        clipper.IncludeItemByIndex(static_cast<int>(selectIO->RangeSrcItem));
+    }
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            size_t i = rows[row];
+            const auto& door = doors[i];
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImGui::SetNextItemSelectionUserData(row);
+            ImGui::Selectable(door.getName().c_str(), selection.isSelected(i),
+                              ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(door.getSounds().c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(door.getTuningParams().c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", door.getMaxOcclusion());
+
+            ImGui::TableNextColumn();
+            if (isModalOpen || isImporting) ImGui::BeginDisabled();
+            if (ImGui::SmallButton("Edit")) {
+                doorWindow.openForEdit(door, i);
+            }
+            if (isModalOpen || isImporting) ImGui::EndDisabled();
+
+            ImGui::SameLine();
+            if (isModalOpen || isImporting) ImGui::BeginDisabled();
+            if (ImGui::SmallButton("Delete")) {
+                deleteDoor(i);
+            }
+            if (isModalOpen || isImporting) ImGui::EndDisabled();
+
+            ImGui::PopID();
+        }
+    }
+    clipper.End();
+
+    selectIO = ImGui::EndMultiSelect();
+    applySelectionRequests(selectIO);
+    selectionRows = nullptr;
+
+    ImGui::EndTable();
+}
+
+const std::vector<size_t>& MainWindow::getSortedFilter() {
+    // Filter results are in door order, reorder them by their rank in the sort
+    doorOrder.getOrder();
+    if (sortedFilterVersion == filterVersion && sortedOrderVersion == doorOrder.getVersion()) {
+        return sortedFilteredDoors;
+    }
+    sortedFilteredDoors = filteredDoors;
+    std::sort(sortedFilteredDoors.begin(), sortedFilteredDoors.end(), [this](size_t a, size_t b) {
+        return doorOrder.getRank(a) < doorOrder.getRank(b);
+    });
+    sortedFilterVersion = filterVersion;
+    sortedOrderVersion = doorOrder.getVersion();
+    return sortedFilteredDoors;
+}
+
+void MainWindow::renderBulkActions() {
+    // Bulk edits are locked while the door window edits a door by index
+    bool isLocked = importJob.isRunning() || doorWindow.isModalOpen();
+    const auto& presets = SettingsManager::getInstance().getSoundPresets();
+    if (bulkPreset >= presets.size()) {
+        bulkPreset = 0;
+    }
+
+    ImGui::PushID("BulkActions");
+    if (isLocked) ImGui::BeginDisabled();
+
+    ImGui::Text("%zu selected", selection.count());
+    ImGui::SameLine(110);
+    ImGui::SetNextItemWidth(160);
+    if (ImGui::BeginCombo("##Preset", presets.empty() ? "No presets" : presets[bulkPreset].name.c_str())) {
+        for (size_t i = 0; i < presets.size(); i++) {
+            bool isSelected = bulkPreset == i;
+            if (ImGui::Selectable(presets[i].name.c_str(), isSelected)) {
+                bulkPreset = i;
+            }
+            if (isSelected) {
+                ImGui::SetItemDefaultFocus();
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    if (presets.empty()) ImGui::BeginDisabled();
+    if (ImGui::Button("Apply preset", ImVec2(100, 20))) {
+        applyPresetToSelection(presets[bulkPreset]);
+    }
+    if (presets.empty()) ImGui::EndDisabled();
+
+    ImGui::SameLine(ImGui::GetWindowWidth() - 110);
+    if (ImGui::Button("Clear", ImVec2(100, 20))) {
+        selection.clear();
+    }
+
+    ImGui::Text("Max Occlusion");
+    ImGui::SameLine(110);
+    ImGui::SetNextItemWidth(160);
+    ImGui::SliderFloat("##Occlusion", &bulkOcclusion, 0.0f, 1.0f, "%.2f");
+    ImGui::SameLine();
+    if (ImGui::Button("Set occlusion", ImVec2(100, 20))) {
+        applyOcclusionToSelection(bulkOcclusion);
+    }
+    ImGui::SameLine(ImGui::GetWindowWidth() - 110);
+    if (ImGui::Button("Delete", ImVec2(100, 20))) {
+        std::vector<size_t> selected = selection.getSelectedIndices();
+        pendingDeletes.insert(pendingDeletes.end(), selected.begin(), selected.end());
+    }
+
+    if (isLocked) ImGui::EndDisabled();
+    ImGui::PopID();
+}
+
+void MainWindow::applyPresetToSelection(const SoundPreset& preset) {
+    // Interned once, every selected door then shares the same handles
+    InternedString sounds(preset.sounds);
+    InternedString tuningParams(preset.tuningParams);
+    history.beginOperation("Apply preset");
+    for (size_t index : selection.getSelectedIndices()) {
+        Door door = doors[index];
+        door.setSounds(sounds);
+        door.setTuningParams(tuningParams);
+        door.setMaxOcclusion(preset.maxOcclusion);
+        doors.updateDoor(index, door);
+    }
+    history.endOperation();
+}
+
+void MainWindow::applyOcclusionToSelection(float maxOcclusion) {
+    history.beginOperation("Set occlusion");
+    for (size_t index : selection.getSelectedIndices()) {
+        Door door = doors[index];
+        door.setMaxOcclusion(maxOcclusion);
+        doors.updateDoor(index, door);
+    }
+    history.endOperation();
+}
+
+void MainWindow::applySelectionRequests(ImGuiMultiSelectIO* selectIO) {
+    // Clearing goes through the visible rows only, doors hidden by the filter are deselected too
+    for (const ImGuiSelectionRequest& request : selectIO->Requests) {
+        if (request.Type == ImGuiSelectionRequestType_SetAll && !request.Selected) {
+            selection.clear();
+        }
+    }
+    selectionStorage.ApplyRequests(selectIO);
+}
+
+void MainWindow::onSetItemSelected(ImGuiSelectionExternalStorage* storage, int row, bool selected) {
+    // Rows are positions in the displayed order, the selection is kept by door index
+    auto* window = static_cast<MainWindow*>(storage->UserData);
+    window->selection.setSelected((*window->selectionRows)[row], selected);
+}
+
+void MainWindow::renderHistoryButtons() {
+    // The door window edits by index, so history is locked while it is open
+    bool isLocked = importJob.isRunning() || doorWindow.isModalOpen();
+    bool canUndo = !isLocked && history.canUndo();
+    bool canRedo = !isLocked && history.canRedo();
+
+    ImGui::SameLine();
+    if (!canUndo) ImGui::BeginDisabled();
+    if (ImGui::Button("Undo", ImVec2(60, 20)) || (canUndo && ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Z))) {
+        history.undo();
+    }
+    if (canUndo) ImGui::SetItemTooltip("Undo %s (Ctrl+Z)", history.getUndoLabel().c_str());
+    if (!canUndo) ImGui::EndDisabled();
+
+    ImGui::SameLine();
+    if (!canRedo) ImGui::BeginDisabled();
+    if (ImGui::Button("Redo", ImVec2(60, 20)) || (canRedo && ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Y))) {
+        history.redo();
+    }
+    if (canRedo) ImGui::SetItemTooltip("Redo %s (Ctrl+Y)", history.getRedoLabel().c_str());
+    if (!canRedo) ImGui::EndDisabled();
+}
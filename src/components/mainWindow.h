@@ -4,7 +4,17 @@
 #include "../settings_manager.h"
 #include "settingsWindow.h"
 #include "doorWindow.h"
+#include "generateWindow.h"
+#include "doorCardCache.h"
+#include "doorSortOrder.h"
+#include "doorSelection.h"
 #include "../doors.h"
+#include "../door_store.h"
+#include "../door_search.h"
+#include "../door_history.h"
+#include "../export_job.h"
+#include "../import_job.h"
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -12,14 +22,64 @@ class MainWindow {
 public:
     MainWindow();
     void render();
+    void setOnRequestRedraw(std::function<void()> callback);
+    bool hasBackgroundWork();
 
 private:
     SettingsWindow settingsWindow;
     DoorWindow doorWindow;
-    std::vector<Door> doors;
+    GenerateWindow generateWindow;
+    DoorStore doors;
+    DoorCardCache doorCards{ doors };  // Must follow doors
+    DoorSearchIndex doorSearch{ doors };
+    DoorSortOrder doorOrder{ doors };
+    DoorSelection selection{ doors };
+    DoorHistory history{ doors };
+    ExportJob exportJob;
+    ImportJob importJob;
+
+    bool isImportRecorded = false;  // The import is an open history operation
+
+    std::vector<size_t> pendingDeletes;  // Removed together at the end of the frame
     void handleDoorAdded(const Door& door);
     void handleDoorEdited(const Door& door, size_t index);
+    size_t handleDoorsGenerated(std::vector<Door> generated);
     void deleteDoor(size_t index);
+    void flushDeletes();
     bool checkDoorExists(const char* name, int currentIndex);
-    void importXmlFile(const std::string& filePath);
+    void importFile(const std::string& filePath);
+    void commitImportBatches();
+    void rollbackImport();
+    void renderImportStatus();
+    void renderExportStatus();
+    void updateFilter();
+    void renderDoorCards(float height, bool isFiltering);
+    void renderDoorTable(float height, bool isFiltering);
+    const std::vector<size_t>& getSortedFilter();
+    void renderBulkActions();
+    void renderHistoryButtons();
+    void applyPresetToSelection(const SoundPreset& preset);
+    void applyOcclusionToSelection(float maxOcclusion);
+    void applySelectionRequests(ImGuiMultiSelectIO* selectIO);
+    static void onSetItemSelected(ImGuiSelectionExternalStorage* storage, int row, bool selected);
+    static int onFilterEdited(ImGuiInputTextCallbackData* data);
+
+    // Door list filter, results are refreshed when the text or the doors change
+    char filterText[256] = "";
+    bool filterDirty = false;
+    uint64_t filterRevision = 0;
+    std::vector<size_t> filteredDoors;
+    uint64_t filterVersion = 0;
+
+    // Table view, filter results reordered by the table sort
+    bool showTable = false;
+    std::vector<size_t> sortedFilteredDoors;
+    uint64_t sortedFilterVersion = static_cast<uint64_t>(-1);
+    uint64_t sortedOrderVersion = 0;
+
+    // Multi-selection in the table, ImGui requests are applied through selectionRows
+    ImGuiSelectionExternalStorage selectionStorage;
+    const std::vector<size_t>* selectionRows = nullptr;
+    size_t bulkPreset = 0;
+    float bulkOcclusion = 0.7f;
 }; 
\ No newline at end of file
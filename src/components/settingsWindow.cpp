@@ -59,6 +59,7 @@ void SettingsWindow::renderPresetManager() {
         tuningParams[0] = '\0';
         maxOcclusion = 0.7f;
         isEditing = true;
+        validationDirty = true;
     }
     ImGui::SameLine();
     if (ImGui::Button("Edit", ImVec2(80, 20))) {
@@ -70,6 +71,7 @@ void SettingsWindow::renderPresetManager() {
             strcpy(sounds, preset.sounds.c_str());
             strcpy(tuningParams, preset.tuningParams.c_str());
             maxOcclusion = preset.maxOcclusion;
+            validationDirty = true;
         }
     }
     ImGui::SameLine();
@@ -120,22 +122,15 @@ void SettingsWindow::renderPresetEditForm() {
 
     ImGui::Spacing();
     ImGui::Text("Preset Name:");
-    ImGui::InputText("PresetName", presetName, IM_ARRAYSIZE(presetName));
+    ImGui::InputText("PresetName", presetName, IM_ARRAYSIZE(presetName),
+        ImGuiInputTextFlags_CallbackEdit, &SettingsWindow::onFieldEdited, this);
+    if (validationDirty) {
+        validateForm();
+    }
 
     // Display error messages if the name is empty or already exists
-    bool nameExists = false;
     bool hasErrors = false;
-    if (isEditing && editingIndex != -1) {
-        const auto& presets = SettingsManager::getInstance().getSoundPresets();
-        if (editingIndex < presets.size()) {
-            nameExists = strcmp(presetName, presets[editingIndex].name.c_str()) != 0 &&
-                        SettingsManager::getInstance().hasSoundPreset(presetName);
-        }
-    } else {
-        nameExists = SettingsManager::getInstance().hasSoundPreset(presetName);
-    }
-
-    if (strlen(presetName) == 0) {
+    if (nameEmpty) {
         ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "The preset name cannot be empty");
         hasErrors = true;
     } else if (nameExists) {
@@ -145,16 +140,18 @@ void SettingsWindow::renderPresetEditForm() {
 
     ImGui::Spacing();
     ImGui::Text("Sounds:");
-    ImGui::InputText("Sounds", sounds, IM_ARRAYSIZE(sounds));
-    if (strlen(sounds) == 0) {
+    ImGui::InputText("Sounds", sounds, IM_ARRAYSIZE(sounds),
+        ImGuiInputTextFlags_CallbackEdit, &SettingsWindow::onFieldEdited, this);
+    if (soundsEmpty) {
         ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "The sounds field cannot be empty");
         hasErrors = true;
     }
 
     ImGui::Spacing();
     ImGui::Text("Tuning Parameters:");
-    ImGui::InputText("TuningParams", tuningParams, IM_ARRAYSIZE(tuningParams));
-    if (strlen(tuningParams) == 0) {
+    ImGui::InputText("TuningParams", tuningParams, IM_ARRAYSIZE(tuningParams),
+        ImGuiInputTextFlags_CallbackEdit, &SettingsWindow::onFieldEdited, this);
+    if (tuningParamsEmpty) {
         ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "The tuning parameters field cannot be empty");
         hasErrors = true;
     }
@@ -197,4 +194,29 @@ void SettingsWindow::resetForm() {
     maxOcclusion = 0.7f;
     isEditing = false;  // Reset edit mode when canceling
     editingIndex = 0;
+    validationDirty = true;
+}
+
+void SettingsWindow::validateForm() {
+    nameEmpty = presetName[0] == '\0';
+    nameExists = false;
+    if (!nameEmpty) {
+        const auto& presets = SettingsManager::getInstance().getSoundPresets();
+        if (editingIndex != -1) {
+            // Keeping the preset's own name is not a duplicate
+            nameExists = editingIndex < presets.size() &&
+                        strcmp(presetName, presets[editingIndex].name.c_str()) != 0 &&
+                        SettingsManager::getInstance().hasSoundPreset(presetName);
+        } else {
+            nameExists = SettingsManager::getInstance().hasSoundPreset(presetName);
+        }
+    }
+    soundsEmpty = sounds[0] == '\0';
+    tuningParamsEmpty = tuningParams[0] == '\0';
+    validationDirty = false;
+}
+
+int SettingsWindow::onFieldEdited(ImGuiInputTextCallbackData* data) {
+    static_cast<SettingsWindow*>(data->UserData)->validationDirty = true;
+    return 0;
 } 
\ No newline at end of file
@@ -15,6 +15,8 @@ private:
     void renderPresetManager();
     void renderPresetEditForm();
     void resetForm();
+    void validateForm();
+    static int onFieldEdited(ImGuiInputTextCallbackData* data);
 
     bool isOpen = false;
     bool isEditing = false;
@@ -23,4 +25,11 @@ private:
     char sounds[256] = "";
     char tuningParams[256] = "";
     float maxOcclusion = 0.0f;
+
+    // Cached form validation, recomputed only when an input changes
+    bool validationDirty = true;
+    bool nameEmpty = true;
+    bool nameExists = false;
+    bool soundsEmpty = true;
+    bool tuningParamsEmpty = true;
 }; 
\ No newline at end of file
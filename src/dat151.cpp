@@ -0,0 +1,142 @@
+#include "dat151.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+bool writeDat151File(const std::vector<Door>& doors, const std::string& filePath,
+                     const Dat151Writer::ProgressCallback& onProgress) {
+    std::string tempPath = filePath + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error writing XML file: " << tempPath << std::endl;
+        return false;
+    }
+
+    // The writer does its own buffering
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    Dat151Writer writer([file](const char* data, size_t size) {
+        return std::fwrite(data, 1, size, file) == size;
+    });
+    writer.setProgressCallback(onProgress);
+
+    bool completed = writer.writeDoors(doors);
+    bool written = writer.finish();
+    if (std::fclose(file) != 0) {
+        written = false;
+    }
+
+    std::error_code error;
+    if (completed && written) {
+        // Swap the finished file in, readers never see a partial export
+        std::filesystem::rename(tempPath, filePath, error);
+        if (!error) {
+            return true;
+        }
+    }
+
+    if (completed) {
+        std::cerr << "Error writing XML file: " << filePath << std::endl;
+    }
+    std::filesystem::remove(tempPath, error);
+    return false;
+}
+
+Door DoorRecordView::toDoor() const {
+    return Door(std::string(name), InternedString(sounds), InternedString(tuningParams), maxOcclusion);
+}
+
+nlohmann::json DoorRecordView::toJson() const {
+    nlohmann::json j;
+    j["name"] = name;
+    j["sounds"] = sounds;
+    j["tuningParams"] = tuningParams;
+    j["maxOcclusion"] = maxOcclusion;
+    return j;
+}
+
+bool Dat151Reader::open(const std::string& filePath) {
+    doc.reset();
+    itemsNode = pugi::xml_node();
+    buffer = std::vector<char>();  // Released, clear() would keep the capacity
+    fileSize = 0;
+
+    pugi::xml_parse_result result;
+    if (file.open(filePath)) {
+        // Parse directly in the copy-on-write mapping
+        result = doc.load_buffer_inplace(file.getData(), file.getSize());
+        fileSize = file.getSize();
+    } else {
+        result = doc.load_file(filePath.c_str());
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(filePath, error);
+        fileSize = error ? 0 : static_cast<size_t>(size);
+    }
+    return findItems(result);
+}
+
+bool Dat151Reader::open(std::istream& input) {
+    std::vector<char> contents(std::istreambuf_iterator<char>(input), (std::istreambuf_iterator<char>()));
+    if (input.bad()) {
+        std::cerr << "Error reading XML input" << std::endl;
+        return false;
+    }
+    return openBuffer(std::move(contents));
+}
+
+bool Dat151Reader::openBuffer(std::vector<char> contents) {
+    doc.reset();
+    itemsNode = pugi::xml_node();
+    file.close();
+
+    buffer = std::move(contents);
+    fileSize = buffer.size();
+    return findItems(doc.load_buffer_inplace(buffer.data(), buffer.size()));
+}
+
+bool Dat151Reader::findItems(const pugi::xml_parse_result& result) {
+    if (!result) {
+        std::cerr << "Error loading XML file: " << result.description() << std::endl;
+        return false;
+    }
+
+    auto dat151Node = doc.child("Dat151");
+    if (!dat151Node) {
+        std::cerr << "No 'Dat151' node found in XML file" << std::endl;
+        return false;
+    }
+
+    itemsNode = dat151Node.child("Items");
+    if (!itemsNode) {
+        std::cerr << "No 'Items' node found in XML file" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Dat151Reader::forEachDoor(const std::function<bool(const DoorRecordView&)>& visitor) const {
+    for (auto itemNode : itemsNode.children("Item")) {
+        auto type = static_cast<Dat151ItemType>(joaat(itemNode.attribute("type").value()));
+        if (type != Dat151ItemType::DoorAudioSettings) {
+            continue;
+        }
+
+        DoorRecordView record;
+        record.name = itemNode.child("Name").text().get();
+        // Remove 'd_' prefix if it exists
+        if (record.name.substr(0, 2) == "d_") {
+            record.name.remove_prefix(2);
+        }
+        record.sounds = itemNode.child("Sounds").text().get();
+        record.tuningParams = itemNode.child("TuningParams").text().get();
+        record.maxOcclusion = itemNode.child("MaxOcclusion").attribute("value").as_float();
+        ptrdiff_t offset = itemNode.offset_debug();
+        record.fileOffset = offset > 0 ? static_cast<size_t>(offset) : 0;
+
+        if (!visitor(record)) {
+            break;
+        }
+    }
+}
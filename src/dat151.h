@@ -0,0 +1,104 @@
+#pragma once
+
+#include "doors.h"
+#include "dat151_writer.h"
+#include "joaat.h"
+#include "mapped_file.h"
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pugixml.hpp>
+
+/**
+ * A DoorAudioSettings item as found in a parsed dat151.rel.xml file
+ * The views point into the reader's buffer and stay valid as long as the
+ * Dat151Reader that produced them.
+ */
+struct DoorRecordView {
+    std::string_view name;          // Item name without the 'd_' prefix
+    std::string_view sounds;
+    std::string_view tuningParams;
+    float maxOcclusion = 0.0f;
+    size_t fileOffset = 0;          // Byte offset of the item in the file
+
+    // Copy the record into an owning Door
+    Door toDoor() const;
+
+    // Same JSON as toDoor().toJson(), without interning the values
+    nlohmann::json toJson() const;
+};
+
+/**
+ * Parser for dat151.rel.xml door resources
+ * The file is memory-mapped and parsed in place, so the only pass over the
+ * bytes is pugixml's own. Falls back to a regular load when the file cannot
+ * be mapped.
+ */
+class Dat151Reader {
+public:
+    /**
+     * Map and parse a dat151.rel.xml file
+     * @param filePath Path of the XML file to read
+     * @return true if the file was parsed and has an Items node, false otherwise
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Read and parse a dat151.rel.xml resource from a stream, e.g. stdin
+     * The stream is read to the end into a buffer owned by the reader.
+     * @param input Stream to read
+     * @return true if the resource was parsed and has an Items node, false otherwise
+     */
+    bool open(std::istream& input);
+
+    /**
+     * Parse a dat151.rel.xml resource already in memory
+     * @param contents Resource bytes, kept and parsed in place by the reader
+     * @return true if the resource was parsed and has an Items node, false otherwise
+     */
+    bool openBuffer(std::vector<char> contents);
+
+    /**
+     * Visit every DoorAudioSettings item in file order
+     * @param visitor Called for each door, returns false to stop early
+     */
+    void forEachDoor(const std::function<bool(const DoorRecordView&)>& visitor) const;
+
+    /**
+     * Size of the parsed file in bytes
+     */
+    size_t getFileSize() const { return fileSize; }
+
+private:
+    bool findItems(const pugi::xml_parse_result& result);
+
+    MappedFile file;
+    std::vector<char> buffer;       // Stream or buffer contents, parsed in place
+    pugi::xml_document doc;
+    pugi::xml_node itemsNode;
+    size_t fileSize = 0;
+};
+
+/**
+ * Hashes of the dat151 item types handled by the tool
+ * Item types are dispatched on these instead of comparing strings.
+ */
+enum class Dat151ItemType : uint32_t {
+    DoorAudioSettings = "DoorAudioSettings"_joaat,
+    DoorAudioSettingsLink = "DoorAudioSettingsLink"_joaat,
+};
+
+/**
+ * Write all doors to a dat151.rel.xml file
+ * Every door produces a DoorAudioSettings item, followed by one
+ * DoorAudioSettingsLink item per door. The output is written to a temporary
+ * file next to filePath, which then atomically replaces it.
+ * @param doors Doors to export
+ * @param filePath Path of the XML file to write
+ * @param onProgress Optional callback polled while writing, returns false to cancel
+ * @return true if the file was written successfully, false on error or cancellation
+ */
+bool writeDat151File(const std::vector<Door>& doors, const std::string& filePath,
+                     const Dat151Writer::ProgressCallback& onProgress = nullptr);
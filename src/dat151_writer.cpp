@@ -0,0 +1,203 @@
+#include "dat151_writer.h"
+#include "joaat.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+/**
+ * Characters that pugixml escapes in PCDATA: control characters other than
+ * tab, line feed and carriage return, '&', '<' and '>'
+ */
+struct PcdataEscapeTable {
+    bool special[256] = {};
+
+    PcdataEscapeTable() {
+        for (int c = 0; c < 32; c++) {
+            special[c] = c != '\t' && c != '\n' && c != '\r';
+        }
+        special[static_cast<unsigned char>('&')] = true;
+        special[static_cast<unsigned char>('<')] = true;
+        special[static_cast<unsigned char>('>')] = true;
+    }
+};
+
+const PcdataEscapeTable escapeTable;
+
+} // namespace
+
+Dat151Writer::Dat151Writer(Sink sink, size_t bufferSize)
+    : sink(std::move(sink))
+    , buffer(bufferSize < 256 ? 256 : bufferSize)
+{}
+
+void Dat151Writer::writeHeader() {
+    char version[16];
+    char* versionEnd = std::to_chars(version, version + sizeof(version), VERSION).ptr;
+
+    appendLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<Dat151>\n"
+                  "\t<Version value=\"");
+    append(version, static_cast<size_t>(versionEnd - version));
+    appendLiteral("\" />\n");
+}
+
+void Dat151Writer::openItems() {
+    if (!itemsOpen) {
+        appendLiteral("\t<Items>\n");
+        itemsOpen = true;
+    }
+}
+
+void Dat151Writer::writeDoorAudioSettings(const Door& door) {
+    openItems();
+    appendLiteral("\t\t<Item type=\"DoorAudioSettings\" ntOffset=\"0\">\n"
+                  "\t\t\t<Name>d_");
+    appendEscaped(door.getName());
+    appendLiteral("</Name>\n"
+                  "\t\t\t<Sounds>");
+    appendEscaped(door.getSounds());
+    appendLiteral("</Sounds>\n"
+                  "\t\t\t<TuningParams>");
+    appendEscaped(door.getTuningParams());
+    appendLiteral("</TuningParams>\n"
+                  "\t\t\t<MaxOcclusion value=\"");
+
+    // Same formatting as pugixml uses for float attributes
+    char number[32];
+    int length = std::snprintf(number, sizeof(number), "%.9g", static_cast<double>(door.getMaxOcclusion()));
+    append(number, static_cast<size_t>(length));
+
+    appendLiteral("\" />\n"
+                  "\t\t</Item>\n");
+}
+
+void Dat151Writer::writeDoorAudioSettingsLink(const Door& door) {
+    writeDoorAudioSettingsLink(door, joaat(door.getName()));
+}
+
+void Dat151Writer::writeDoorAudioSettingsLink(const Door& door, uint32_t nameHash) {
+    writeDoorAudioSettingsLink(door.getName(), nameHash);
+}
+
+void Dat151Writer::writeDoorAudioSettingsLink(const std::string& doorName, uint32_t nameHash) {
+    openItems();
+    char hash[JOAAT_HEX_LENGTH];
+    formatJoaatHex(nameHash, hash);
+
+    appendLiteral("\t\t<Item type=\"DoorAudioSettingsLink\" ntOffset=\"0\">\n"
+                  "\t\t\t<Name>dasl_");
+    append(hash, sizeof(hash));
+    appendLiteral("</Name>\n"
+                  "\t\t\t<Door>d_");
+    appendEscaped(doorName);
+    appendLiteral("</Door>\n"
+                  "\t\t</Item>\n");
+}
+
+void Dat151Writer::writeFooter() {
+    if (itemsOpen) {
+        appendLiteral("\t</Items>\n"
+                      "</Dat151>\n");
+    } else {
+        appendLiteral("\t<Items />\n"
+                      "</Dat151>\n");
+    }
+}
+
+bool Dat151Writer::writeDoors(const std::vector<Door>& doors) {
+    writeHeader();
+
+    // First pass: Generate all DoorAudioSettings
+    for (size_t i = 0; i < doors.size(); i++) {
+        if (i % PROGRESS_INTERVAL == 0 && !reportProgress(i)) {
+            return false;
+        }
+        writeDoorAudioSettings(doors[i]);
+    }
+
+    // Second pass: Generate all DoorAudioSettingsLink, hashing the names in batches
+    constexpr size_t HASH_BATCH_SIZE = 64;
+    static_assert(PROGRESS_INTERVAL % HASH_BATCH_SIZE == 0, "progress is reported between batches");
+    std::string_view names[HASH_BATCH_SIZE];
+    uint32_t hashes[HASH_BATCH_SIZE];
+
+    for (size_t first = 0; first < doors.size(); first += HASH_BATCH_SIZE) {
+        if (first % PROGRESS_INTERVAL == 0 && !reportProgress(doors.size() + first)) {
+            return false;
+        }
+
+        size_t count = std::min(HASH_BATCH_SIZE, doors.size() - first);
+        for (size_t i = 0; i < count; i++) {
+            names[i] = doors[first + i].getName();
+        }
+        joaatBatch(names, count, hashes);
+        for (size_t i = 0; i < count; i++) {
+            writeDoorAudioSettingsLink(doors[first + i], hashes[i]);
+        }
+    }
+
+    writeFooter();
+    return reportProgress(doors.size() * 2);
+}
+
+bool Dat151Writer::finish() {
+    flush();
+    return !failed;
+}
+
+bool Dat151Writer::reportProgress(size_t itemsWritten) {
+    return !onProgress || onProgress(itemsWritten);
+}
+
+void Dat151Writer::append(const char* data, size_t size) {
+    while (size > 0) {
+        if (used == buffer.size()) {
+            flush();
+        }
+        size_t chunk = std::min(size, buffer.size() - used);
+        std::memcpy(buffer.data() + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void Dat151Writer::appendEscaped(const std::string& text) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    while (p != end) {
+        // Copy the longest run that needs no escaping in one go
+        const char* run = p;
+        while (p != end && !escapeTable.special[static_cast<unsigned char>(*p)]) {
+            ++p;
+        }
+        append(run, static_cast<size_t>(p - run));
+        if (p == end) {
+            break;
+        }
+
+        unsigned char c = static_cast<unsigned char>(*p++);
+        switch (c) {
+            case '&': appendLiteral("&amp;"); break;
+            case '<': appendLiteral("&lt;"); break;
+            case '>': appendLiteral("&gt;"); break;
+            default: {
+                char entity[5] = { '&', '#', static_cast<char>('0' + c / 10), static_cast<char>('0' + c % 10), ';' };
+                append(entity, sizeof(entity));
+                break;
+            }
+        }
+    }
+}
+
+void Dat151Writer::flush() {
+    if (used > 0 && !failed) {
+        failed = !sink(buffer.data(), used);
+    }
+    used = 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "doors.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Streaming writer for dat151.rel.xml door resources
+ * Items are serialized straight into a large output buffer which is handed
+ * to the sink whenever it fills up, so no XML document is built in memory.
+ * The output is byte-identical to a pugixml document saved with the default
+ * formatting options.
+ */
+class Dat151Writer {
+public:
+    /**
+     * Receives a chunk of serialized output
+     * @return true if the chunk was consumed, false to abort writing
+     */
+    using Sink = std::function<bool(const char* data, size_t size)>;
+
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    // Value of the Version node written by writeHeader
+    static constexpr uint32_t VERSION = 9458585;
+
+    // Bumped whenever the serialized output changes, so cached exports are rebuilt
+    static constexpr uint32_t FORMAT_REVISION = 1;
+
+    /**
+     * Receives the number of items written so far by writeDoors
+     * @return true to continue, false to cancel the export
+     */
+    using ProgressCallback = std::function<bool(size_t itemsWritten)>;
+
+    // Number of items written between two progress callbacks
+    static constexpr size_t PROGRESS_INTERVAL = 1024;
+
+    explicit Dat151Writer(Sink sink, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Write the XML declaration, the Dat151 root and the Version node
+     */
+    void writeHeader();
+
+    /**
+     * Write the DoorAudioSettings item of a door
+     */
+    void writeDoorAudioSettings(const Door& door);
+
+    /**
+     * Write the DoorAudioSettingsLink item of a door
+     */
+    void writeDoorAudioSettingsLink(const Door& door);
+
+    /**
+     * Write the DoorAudioSettingsLink item of a door whose joaat name hash
+     * is already known
+     */
+    void writeDoorAudioSettingsLink(const Door& door, uint32_t nameHash);
+
+    /**
+     * Write the DoorAudioSettingsLink item of a door known only by name, for
+     * streams that do not keep the doors once their settings are written
+     */
+    void writeDoorAudioSettingsLink(const std::string& doorName, uint32_t nameHash);
+
+    /**
+     * Write the closing Items and Dat151 tags
+     */
+    void writeFooter();
+
+    /**
+     * Write a complete resource: header, all DoorAudioSettings, all
+     * DoorAudioSettingsLink and footer
+     * @return true if every item was written, false if the progress callback cancelled
+     */
+    bool writeDoors(const std::vector<Door>& doors);
+
+    /**
+     * Set the callback polled by writeDoors every PROGRESS_INTERVAL items
+     */
+    void setProgressCallback(ProgressCallback callback) { onProgress = std::move(callback); }
+
+    /**
+     * Flush the remaining buffered output to the sink
+     * @return true if every chunk was accepted by the sink, false otherwise
+     */
+    bool finish();
+
+private:
+    void openItems();
+    void append(const char* data, size_t size);
+    void appendEscaped(const std::string& text);
+    void flush();
+
+    template <size_t N>
+    void appendLiteral(const char (&literal)[N]) { append(literal, N - 1); }
+
+    bool reportProgress(size_t itemsWritten);
+
+    Sink sink;
+    ProgressCallback onProgress;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+    bool itemsOpen = false;
+};
@@ -0,0 +1,319 @@
+#include "door_csv.h"
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    bool isBlank(char c) {
+        return c == ' ' || c == '\r';
+    }
+
+    std::string_view trim(std::string_view str) {
+        while (!str.empty() && isBlank(str.front())) {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && isBlank(str.back())) {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+
+    // "Max Occlusion", "max_occlusion" and "maxOcclusion" name the same column
+    std::string normalizeHeader(std::string_view header) {
+        std::string key;
+        for (char c : header) {
+            if (c == ' ' || c == '_' || c == '-') {
+                continue;
+            }
+            key += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        return key;
+    }
+
+    // Spreadsheets in locales using ';' as delimiter write "0,7" for 0.7
+    bool parseOcclusion(std::string_view value, float& occlusion) {
+        char buffer[32];
+        if (value.size() >= sizeof(buffer)) {
+            return false;
+        }
+        for (size_t i = 0; i < value.size(); i++) {
+            buffer[i] = value[i] == ',' ? '.' : value[i];
+        }
+#if defined(__cpp_lib_to_chars)
+        auto [end, error] = std::from_chars(buffer, buffer + value.size(), occlusion);
+        bool isParsed = error == std::errc() && end == buffer + value.size();
+#else
+        // Older libc++ has no floating-point from_chars; the tool never calls
+        // setlocale, so strtof reads '.' decimals like from_chars would
+        buffer[value.size()] = '\0';
+        char* end = nullptr;
+        errno = 0;
+        occlusion = std::strtof(buffer, &end);
+        bool isParsed = !value.empty() && errno == 0 && end == buffer + value.size();
+#endif
+        return isParsed && occlusion >= 0.0f && occlusion <= 1.0f;
+    }
+}
+
+bool DoorCsvReader::open(const std::string& path, const PresetIndex& presetIndex) {
+    filePath = path;
+    presets = &presetIndex;
+    if (!file.open(path)) {
+        std::cerr << "Error opening file (missing or empty): " << path << std::endl;
+        return false;
+    }
+    const char* data = file.getData();
+    size_t size = file.getSize();
+
+    // Skip the UTF-8 byte order mark spreadsheet tools like to add
+    position = (size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF') ? 3 : 0;
+    line = 1;
+
+    // The delimiter is the most frequent candidate on the first line
+    size_t commas = 0;
+    size_t semicolons = 0;
+    size_t tabs = 0;
+    bool quoted = false;
+    for (size_t i = position; i < size && (quoted || data[i] != '\n'); i++) {
+        char c = data[i];
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (!quoted) {
+            commas += c == ',';
+            semicolons += c == ';';
+            tabs += c == '\t';
+        }
+    }
+    delimiter = ',';
+    if (tabs > 0 && tabs >= commas && tabs >= semicolons) {
+        delimiter = '\t';
+    } else if (semicolons > commas) {
+        delimiter = ';';
+    }
+
+    // Headerless layout, unless the first row names a "name" column
+    size_t firstRow = position;
+    size_t firstLine = line;
+    for (size_t& column : columns) {
+        column = NO_FIELD;
+    }
+    columns[COLUMN_NAME] = 0;
+    columns[COLUMN_SOUNDS] = 1;
+    columns[COLUMN_TUNING_PARAMS] = 2;
+    columns[COLUMN_MAX_OCCLUSION] = 3;
+    soundsMayBePreset = true;
+
+    bool hasHeader = false;
+    if (readRow()) {
+        for (std::string_view header : fields) {
+            hasHeader |= normalizeHeader(header) == "name";
+        }
+    }
+    if (hasHeader) {
+        for (size_t& column : columns) {
+            column = NO_FIELD;
+        }
+        for (size_t i = 0; i < fields.size(); i++) {
+            std::string key = normalizeHeader(fields[i]);
+            if (key == "name") {
+                columns[COLUMN_NAME] = i;
+            } else if (key == "preset") {
+                columns[COLUMN_PRESET] = i;
+            } else if (key == "sounds") {
+                columns[COLUMN_SOUNDS] = i;
+            } else if (key == "tuningparams") {
+                columns[COLUMN_TUNING_PARAMS] = i;
+            } else if (key == "maxocclusion" || key == "occlusion") {
+                columns[COLUMN_MAX_OCCLUSION] = i;
+            }
+        }
+        soundsMayBePreset = false;
+        dataStart = position;
+        dataLine = line;
+    } else {
+        dataStart = firstRow;
+        dataLine = firstLine;
+    }
+    return true;
+}
+
+void DoorCsvReader::forEachDoor(const std::function<bool(Door& door, size_t fileOffset)>& visitor) {
+    skippedRows = 0;
+    if (!file.isOpen()) {
+        return;
+    }
+    position = dataStart;
+    line = dataLine;
+
+    Door door;
+    std::string error;
+    while (readRow()) {
+        bool isEmpty = true;
+        for (std::string_view value : fields) {
+            isEmpty &= value.empty();
+        }
+        if (isEmpty) {
+            continue;
+        }
+
+        if (!parseRow(door, error)) {
+            std::cerr << filePath << ":" << rowLine << ": " << error << std::endl;
+            skippedRows++;
+            continue;
+        }
+        if (!visitor(door, rowOffset)) {
+            return;
+        }
+    }
+}
+
+bool DoorCsvReader::readRow() {
+    const char* data = file.getData();
+    size_t size = file.getSize();
+    if (position >= size) {
+        return false;
+    }
+
+    // The mapping is left untouched so rows can be read again, e.g. the header probe
+    fields.clear();
+    escapedFields.clear();
+    rowOffset = position;
+    rowLine = line;
+    bool isRowEnd = false;
+    while (!isRowEnd) {
+        size_t start = position;
+        if (position < size && data[position] == '"') {
+            // Quoted field: "" stands for one quote and is unescaped once the row is read
+            start = ++position;
+            size_t end = size;
+            bool hasEscapes = false;
+            while (position < size) {
+                char c = data[position++];
+                if (c == '"') {
+                    if (position < size && data[position] == '"') {
+                        position++;
+                        hasEscapes = true;
+                    } else {
+                        end = position - 1;
+                        break;
+                    }
+                } else if (c == '\n') {
+                    line++;
+                }
+            }
+            if (hasEscapes) {
+                escapedFields.push_back(fields.size());
+            }
+            fields.push_back(std::string_view(data + start, end - start));
+
+            // Anything between the closing quote and the delimiter is ignored
+            while (position < size && data[position] != delimiter && data[position] != '\n') {
+                position++;
+            }
+        } else {
+            while (position < size && data[position] != delimiter && data[position] != '\n') {
+                position++;
+            }
+            fields.push_back(trim(std::string_view(data + start, position - start)));
+        }
+
+        if (position >= size) {
+            isRowEnd = true;
+        } else if (data[position++] == '\n') {
+            line++;
+            isRowEnd = true;
+        }
+    }
+
+    if (!escapedFields.empty()) {
+        unescapeFields();
+    }
+    return true;
+}
+
+void DoorCsvReader::unescapeFields() {
+    // Reserved up front, the views stay valid while the row is unescaped
+    size_t total = 0;
+    for (size_t index : escapedFields) {
+        total += fields[index].size();
+    }
+    unescaped.clear();
+    unescaped.reserve(total);
+
+    for (size_t index : escapedFields) {
+        std::string_view raw = fields[index];
+        size_t start = unescaped.size();
+        for (size_t i = 0; i < raw.size(); i++) {
+            unescaped += raw[i];
+            if (raw[i] == '"') {
+                i++;
+            }
+        }
+        fields[index] = std::string_view(unescaped.data() + start, unescaped.size() - start);
+    }
+}
+
+bool DoorCsvReader::parseRow(Door& door, std::string& error) {
+    std::string_view name = field(COLUMN_NAME);
+    std::string_view presetName = field(COLUMN_PRESET);
+    std::string_view sounds = field(COLUMN_SOUNDS);
+    std::string_view tuningParams = field(COLUMN_TUNING_PARAMS);
+    std::string_view maxOcclusion = field(COLUMN_MAX_OCCLUSION);
+
+    if (name.empty()) {
+        error = "missing door name";
+        return false;
+    }
+
+    const PresetIndex::Entry* preset = nullptr;
+    if (!presetName.empty()) {
+        preset = presets->find(presetName);
+        if (!preset) {
+            error = "unknown preset '" + std::string(presetName) + "'";
+            return false;
+        }
+    } else if (soundsMayBePreset && !sounds.empty()) {
+        preset = presets->find(sounds);
+        if (preset) {
+            sounds = std::string_view();
+        }
+    }
+
+    // Intern through the last value seen in the column, which saves the pool lookup on repeats
+    auto intern = [](InternedString& last, std::string_view value) {
+        if (last.str() != value) {
+            last = InternedString(value);
+        }
+        return last;
+    };
+
+    InternedString doorSounds = preset ? preset->sounds : InternedString();
+    InternedString doorTuningParams = preset ? preset->tuningParams : InternedString();
+    float occlusion = preset ? preset->maxOcclusion : 0.7f;
+
+    if (!sounds.empty()) {
+        doorSounds = intern(lastSounds, sounds);
+    } else if (!preset) {
+        error = "missing sounds or preset";
+        return false;
+    }
+    if (!tuningParams.empty()) {
+        doorTuningParams = intern(lastTuningParams, tuningParams);
+    } else if (!preset) {
+        error = "missing tuningParams";
+        return false;
+    }
+    if (!maxOcclusion.empty() && !parseOcclusion(maxOcclusion, occlusion)) {
+        error = "invalid maxOcclusion '" + std::string(maxOcclusion) + "'";
+        return false;
+    }
+
+    door = Door(std::string(name), doorSounds, doorTuningParams, occlusion);
+    return true;
+}
+
+std::string_view DoorCsvReader::field(Column column) const {
+    size_t index = columns[column];
+    return index < fields.size() ? fields[index] : std::string_view();
+}
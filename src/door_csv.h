@@ -0,0 +1,82 @@
+#pragma once
+
+#include "doors.h"
+#include "mapped_file.h"
+#include "preset_index.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Streaming reader for door lists exported from spreadsheets (CSV or TSV)
+ * The file is memory-mapped and walked once, one row at a time, so memory
+ * use does not grow with the number of rows. The delimiter (comma,
+ * semicolon or tab) is detected from the first line.
+ *
+ * An optional header row names the columns: name, preset, sounds,
+ * tuningParams and maxOcclusion, in any order and case. Without a header
+ * the columns are name, sounds, tuningParams and maxOcclusion, where the
+ * second column may hold a preset name instead of a sounds hash. Values
+ * given next to a preset override the preset's values.
+ */
+class DoorCsvReader {
+public:
+    /**
+     * Map a CSV or TSV file and read its header
+     * @param filePath Path of the file to read
+     * @param presets Presets that rows may refer to, must outlive the reader
+     * @return true if the file was opened, false otherwise
+     */
+    bool open(const std::string& filePath, const PresetIndex& presets);
+
+    /**
+     * Visit every door row in file order
+     * Invalid rows are reported on std::cerr and skipped.
+     * @param visitor Called for each door with the byte offset of its row, returns false to stop early
+     */
+    void forEachDoor(const std::function<bool(Door& door, size_t fileOffset)>& visitor);
+
+    /**
+     * Size of the file in bytes
+     */
+    size_t getFileSize() const { return file.getSize(); }
+
+    /**
+     * Number of rows skipped by the last forEachDoor because they were invalid
+     */
+    size_t getSkippedRows() const { return skippedRows; }
+
+private:
+    enum Column { COLUMN_NAME, COLUMN_PRESET, COLUMN_SOUNDS, COLUMN_TUNING_PARAMS, COLUMN_MAX_OCCLUSION, COLUMN_COUNT };
+    static constexpr size_t NO_FIELD = static_cast<size_t>(-1);
+
+    bool readRow();
+    void unescapeFields();
+    bool parseRow(Door& door, std::string& error);
+    std::string_view field(Column column) const;
+
+    MappedFile file;
+    std::string filePath;
+    const PresetIndex* presets = nullptr;
+    char delimiter = ',';
+    bool soundsMayBePreset = true;      // Headerless files: the sounds column may name a preset
+    size_t columns[COLUMN_COUNT] = {};  // Field of each column in a row, or NO_FIELD
+    size_t dataStart = 0;               // Offset of the first row after the header
+    size_t dataLine = 1;
+
+    // Cursor over the mapping
+    size_t position = 0;
+    size_t line = 0;
+    size_t rowOffset = 0;
+    size_t rowLine = 0;
+    std::vector<std::string_view> fields;  // Views into the mapping or into unescaped, reused for every row
+    std::vector<size_t> escapedFields;     // Quoted fields of the row holding "" escapes
+    std::string unescaped;                 // Unescaped copies of those fields
+
+    // Consecutive rows usually repeat the same values
+    InternedString lastSounds;
+    InternedString lastTuningParams;
+
+    size_t skippedRows = 0;
+};
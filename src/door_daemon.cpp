@@ -0,0 +1,467 @@
+#include "door_daemon.h"
+#include "dat151.h"
+#include "door_manifest.h"
+#include "mapped_file.h"
+#include "settings_manager.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const size_t FRAME_HEADER_SIZE = 5;
+
+    // Bytes read from a ready connection at once
+    const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+    // A client that stops reading its response is dropped after this long
+    const int SEND_TIMEOUT_SECONDS = 5;
+
+    uint32_t decodeFrameSize(const unsigned char* header) {
+        return static_cast<uint32_t>(header[0]) | static_cast<uint32_t>(header[1]) << 8 |
+               static_cast<uint32_t>(header[2]) << 16 | static_cast<uint32_t>(header[3]) << 24;
+    }
+
+    // Dat151Writer's default buffer is sized for files, responses are usually small
+    const size_t RESPONSE_BUFFER_SIZE = 64 * 1024;
+
+    std::string joinErrors(const std::vector<std::string>& errors) {
+        std::string joined;
+        for (const auto& error : errors) {
+            joined += error;
+            joined += '\n';
+        }
+        return joined;
+    }
+}
+
+DoorDaemon::DoorDaemon(std::string settingsPath, std::string cacheDirectory)
+    : settingsPath(std::move(settingsPath))
+    , useExportCache(!cacheDirectory.empty())
+    , exportCache(std::move(cacheDirectory)) {
+}
+
+DoorDaemon::~DoorDaemon() {
+#ifndef _WIN32
+    if (listenSocket >= 0) {
+        ::close(listenSocket);
+        ::unlink(socketPath.c_str());
+    }
+#endif
+}
+
+DoorDaemon::Status DoorDaemon::handle(Request type, const std::string& payload, std::string& response) {
+    response.clear();
+    switch (type) {
+        case Request::Export: {
+            std::vector<Door> doors;
+            if (!refreshPresets(response) || !parseManifest(payload, doors, response)) {
+                return Status::Error;
+            }
+            Dat151Writer writer([&response](const char* data, size_t size) {
+                response.append(data, size);
+                return true;
+            }, RESPONSE_BUFFER_SIZE);
+            writer.writeDoors(doors);
+            writer.finish();
+            return Status::Ok;
+        }
+
+        case Request::ExportFile: {
+            size_t separator = payload.find('\0');
+            if (separator == std::string::npos) {
+                response = "expected a manifest path and an output path separated by a null character\n";
+                return Status::Error;
+            }
+            std::string outputPath = payload.substr(separator + 1);
+            if (!refreshPresets(response)) {
+                return Status::Error;
+            }
+            const CachedManifest* manifest = loadManifest(payload.substr(0, separator), response);
+            if (!manifest) {
+                return Status::Error;
+            }
+            if (!useExportCache || !exportCache.isUpToDate(outputPath, manifest->fingerprint)) {
+                if (!writeDat151File(manifest->doors, outputPath)) {
+                    response = "failed to write " + outputPath + "\n";
+                    return Status::Error;
+                }
+                if (useExportCache) {
+                    exportCache.store(outputPath, manifest->fingerprint);
+                }
+            }
+            response = std::to_string(manifest->doors.size());
+            return Status::Ok;
+        }
+
+        case Request::Import: {
+            Dat151Reader reader;
+            if (!reader.openBuffer(std::vector<char>(payload.begin(), payload.end()))) {
+                response = "invalid dat151 resource\n";
+                return Status::Error;
+            }
+            reader.forEachDoor([&response](const DoorRecordView& record) {
+                response += record.toJson().dump();
+                response += '\n';
+                return true;
+            });
+            return Status::Ok;
+        }
+
+        case Request::Validate: {
+            std::vector<Door> doors;
+            if (!refreshPresets(response) || !parseManifest(payload, doors, response)) {
+                return Status::Error;
+            }
+            response = std::to_string(doors.size());
+            return Status::Ok;
+        }
+
+        case Request::Shutdown:
+            stopRequested = true;
+            return Status::Ok;
+    }
+
+    response = "unknown request type " + std::to_string(static_cast<int>(type)) + "\n";
+    return Status::Error;
+}
+
+bool DoorDaemon::refreshPresets(std::string& response) {
+    // A stat per request is much cheaper than parsing the settings again
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(settingsPath, error);
+    if (hasPresets && (error || modified == settingsModified)) {
+        return true;
+    }
+
+    std::vector<SoundPreset> loaded;
+    if (!SettingsManager::readPresetsFile(settingsPath, loaded)) {
+        response = "failed to read settings file " + settingsPath + "\n";
+        return false;
+    }
+    presetList = std::move(loaded);
+    presets = PresetIndex(presetList);
+    settingsModified = modified;
+    hasPresets = true;
+
+    // Cached manifests were resolved against the previous presets
+    manifests.clear();
+    std::cerr << "Loaded " << presets.size() << " sound presets from " << settingsPath << std::endl;
+    return true;
+}
+
+bool DoorDaemon::parseManifest(const std::string& text, std::vector<Door>& doors, std::string& response) {
+    std::vector<std::string> errors;
+    if (!parseDoorManifest(text.data(), text.data() + text.size(), presets, doors, errors)) {
+        response = joinErrors(errors);
+        return false;
+    }
+    return true;
+}
+
+const DoorDaemon::CachedManifest* DoorDaemon::loadManifest(const std::string& path, std::string& response) {
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(path, error);
+    uintmax_t size = error ? 0 : std::filesystem::file_size(path, error);
+    if (error) {
+        response = "failed to open manifest " + path + "\n";
+        return nullptr;
+    }
+
+    auto it = manifests.find(path);
+    if (it != manifests.end() && it->second.modified == modified && it->second.size == size) {
+        return &it->second;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        response = "failed to open manifest " + path + "\n";
+        return nullptr;
+    }
+    CachedManifest manifest;
+    manifest.modified = modified;
+    manifest.size = size;
+    std::vector<std::string> errors;
+    if (!parseDoorManifest(file.getData(), file.getData() + file.getSize(), presets, manifest.doors, errors)) {
+        response = joinErrors(errors);
+        manifests.erase(path);
+        return nullptr;
+    }
+    manifest.fingerprint = fingerprintDat151Manifest(std::string_view(file.getData(), file.getSize()), presetList);
+    return &(manifests[path] = std::move(manifest));
+}
+
+#ifndef _WIN32
+
+namespace {
+    bool writeAll(int connection, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(connection, data, size);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool readAll(int connection, char* data, size_t size) {
+        while (size > 0) {
+            ssize_t received = ::read(connection, data, size);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return false;
+            }
+            data += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    bool makeSocketAddress(const std::string& path, sockaddr_un& address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Invalid socket path: " << path << std::endl;
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+}
+
+bool DoorDaemon::listen(const std::string& path) {
+    sockaddr_un address;
+    if (!makeSocketAddress(path, address)) {
+        return false;
+    }
+
+    // Only replace the socket file if no daemon answers on it
+    int existing = connectDoorDaemon(path);
+    if (existing >= 0) {
+        closeDoorDaemonConnection(existing);
+        std::cerr << "A daemon is already listening on " << path << std::endl;
+        return false;
+    }
+    ::unlink(path.c_str());
+
+    listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        std::cerr << "Failed to create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket, 16) != 0) {
+        std::cerr << "Failed to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+    socketPath = path;
+
+    // A client going away mid-response must not kill the daemon
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Load the presets now rather than on the first request
+    std::string error;
+    if (!refreshPresets(error)) {
+        std::cerr << error;
+    }
+    std::cerr << "Listening on " << path << std::endl;
+    return true;
+}
+
+void DoorDaemon::run() {
+    // Connections are multiplexed with poll, so an idle or slow client never
+    // holds up the others. Requests are still handled one at a time.
+    std::vector<Connection> connections;
+    std::vector<pollfd> polled;
+    stopRequested = false;
+    while (listenSocket >= 0 && !stopRequested) {
+        polled.clear();
+        polled.push_back({ listenSocket, POLLIN, 0 });
+        for (const auto& connection : connections) {
+            polled.push_back({ connection.socket, POLLIN, 0 });
+        }
+        if (::poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Failed to wait for connections: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        // Connections accepted now are polled from the next iteration
+        size_t polledConnections = connections.size();
+        if (polled[0].revents & POLLIN) {
+            int socket = ::accept(listenSocket, nullptr, nullptr);
+            if (socket >= 0) {
+                timeval timeout = { SEND_TIMEOUT_SECONDS, 0 };
+                ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                connections.push_back({ socket, std::string() });
+            } else if (errno != EINTR && errno != ECONNABORTED) {
+                std::cerr << "Failed to accept a connection: " << std::strerror(errno) << std::endl;
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < polledConnections && !stopRequested; i++) {
+            if (polled[i + 1].revents != 0 && !serveConnection(connections[i])) {
+                ::close(connections[i].socket);
+                connections[i].socket = -1;
+            }
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(), [](const Connection& connection) {
+            return connection.socket < 0;
+        }), connections.end());
+    }
+
+    for (const auto& connection : connections) {
+        ::close(connection.socket);
+    }
+    if (listenSocket >= 0) {
+        ::close(listenSocket);
+        ::unlink(socketPath.c_str());
+        listenSocket = -1;
+    }
+}
+
+bool DoorDaemon::serveConnection(Connection& connection) {
+    // Poll said the socket is ready, so this read does not block
+    size_t received = connection.input.size();
+    connection.input.resize(received + READ_CHUNK_SIZE);
+    ssize_t count = ::read(connection.socket, connection.input.data() + received, READ_CHUNK_SIZE);
+    if (count < 0 && errno == EINTR) {
+        connection.input.resize(received);
+        return true;
+    }
+    if (count <= 0) {
+        return false;
+    }
+    connection.input.resize(received + static_cast<size_t>(count));
+
+    // Answer every complete frame, a partial one waits for more bytes
+    size_t offset = 0;
+    std::string payload;
+    std::string response;
+    while (!stopRequested && connection.input.size() - offset >= FRAME_HEADER_SIZE) {
+        const unsigned char* header = reinterpret_cast<const unsigned char*>(connection.input.data() + offset);
+        uint32_t size = decodeFrameSize(header);
+        if (size > MAX_FRAME_SIZE) {
+            std::cerr << "Rejected a frame of " << size << " bytes" << std::endl;
+            return false;
+        }
+        if (connection.input.size() - offset - FRAME_HEADER_SIZE < size) {
+            break;
+        }
+        Request type = static_cast<Request>(header[4]);
+        payload.assign(connection.input, offset + FRAME_HEADER_SIZE, size);
+        offset += FRAME_HEADER_SIZE + size;
+
+        Status status = handle(type, payload, response);
+        if (!writeDaemonFrame(connection.socket, static_cast<uint8_t>(status), response)) {
+            return false;
+        }
+    }
+    connection.input.erase(0, offset);
+    return true;
+}
+
+int connectDoorDaemon(const std::string& socketPath) {
+    sockaddr_un address;
+    if (!makeSocketAddress(socketPath, address)) {
+        return -1;
+    }
+    int connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0) {
+        return -1;
+    }
+    if (::connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(connection);
+        return -1;
+    }
+    return connection;
+}
+
+void closeDoorDaemonConnection(int connection) {
+    if (connection >= 0) {
+        ::close(connection);
+    }
+}
+
+bool writeDaemonFrame(int connection, uint8_t type, const std::string& payload) {
+    if (payload.size() > DoorDaemon::MAX_FRAME_SIZE) {
+        return false;
+    }
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    char header[FRAME_HEADER_SIZE] = {
+        static_cast<char>(size & 0xFF),
+        static_cast<char>((size >> 8) & 0xFF),
+        static_cast<char>((size >> 16) & 0xFF),
+        static_cast<char>((size >> 24) & 0xFF),
+        static_cast<char>(type)
+    };
+    return writeAll(connection, header, sizeof(header)) && writeAll(connection, payload.data(), payload.size());
+}
+
+bool readDaemonFrame(int connection, uint8_t& type, std::string& payload) {
+    unsigned char header[FRAME_HEADER_SIZE];
+    if (!readAll(connection, reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    uint32_t size = decodeFrameSize(header);
+    if (size > DoorDaemon::MAX_FRAME_SIZE) {
+        std::cerr << "Rejected a frame of " << size << " bytes" << std::endl;
+        return false;
+    }
+    type = header[4];
+    payload.resize(size);
+    return readAll(connection, payload.data(), size);
+}
+
+#else
+
+bool DoorDaemon::listen(const std::string&) {
+    std::cerr << "The daemon needs Unix domain sockets, which this platform build does not support" << std::endl;
+    return false;
+}
+
+void DoorDaemon::run() {
+}
+
+bool DoorDaemon::serveConnection(Connection&) {
+    return false;
+}
+
+int connectDoorDaemon(const std::string&) {
+    return -1;
+}
+
+void closeDoorDaemonConnection(int) {
+}
+
+bool writeDaemonFrame(int, uint8_t, const std::string&) {
+    return false;
+}
+
+bool readDaemonFrame(int, uint8_t&, std::string&) {
+    return false;
+}
+
+#endif
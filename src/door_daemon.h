@@ -0,0 +1,141 @@
+#pragma once
+
+#include "doors.h"
+#include "export_cache.h"
+#include "preset_index.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Long-lived export server listening on a Unix domain socket
+ * Presets, interned strings and parsed manifests stay in memory between
+ * requests, so a request only pays for its own work instead of process
+ * startup and a settings parse. Only available on POSIX systems.
+ *
+ * Protocol: every message is a frame made of a 4-byte little-endian payload
+ * length, a 1-byte type and the payload. A connection may send any number
+ * of requests; each gets exactly one response frame whose type is a Status.
+ *
+ *   Export      payload: manifest JSON         response: dat151.rel.xml
+ *   ExportFile  payload: manifest path '\0'    response: door count
+ *                        output path           (the output is left untouched when the
+ *                                              export cache says it is up to date)
+ *                        Relative paths resolve against the daemon's working directory.
+ *   Import      payload: dat151.rel.xml        response: JSON lines, one door per line
+ *   Validate    payload: manifest JSON         response: door count
+ *   Shutdown    payload: empty                 response: empty, then the daemon exits
+ *
+ * Error responses carry the problems found, one per line.
+ */
+class DoorDaemon {
+public:
+    enum class Request : uint8_t {
+        Export = 1,
+        ExportFile = 2,
+        Import = 3,
+        Validate = 4,
+        Shutdown = 5
+    };
+
+    enum class Status : uint8_t {
+        Ok = 0,
+        Error = 1
+    };
+
+    // Larger frames are rejected before anything is allocated
+    static constexpr uint32_t MAX_FRAME_SIZE = 256u << 20;
+
+    /**
+     * @param settingsPath settings.json with the presets manifests refer to,
+     *                     read again whenever it changes on disk
+     * @param cacheDirectory ExportCache directory for ExportFile requests, empty to always write
+     */
+    explicit DoorDaemon(std::string settingsPath, std::string cacheDirectory = "");
+    ~DoorDaemon();
+
+    DoorDaemon(const DoorDaemon&) = delete;
+    DoorDaemon& operator=(const DoorDaemon&) = delete;
+
+    /**
+     * Create the socket and start listening
+     * A stale socket file left by a previous daemon is replaced.
+     * @param socketPath Path of the socket file
+     * @return true if the daemon is listening, false otherwise
+     */
+    bool listen(const std::string& socketPath);
+
+    /**
+     * Serve every connected client until a Shutdown request
+     * Clients are multiplexed with poll and their requests handled in arrival order.
+     */
+    void run();
+
+    /**
+     * Handle one request, independently of the transport
+     * @param type Request type
+     * @param payload Request payload
+     * @param response Receives the response payload
+     * @return Status of the response
+     */
+    Status handle(Request type, const std::string& payload, std::string& response);
+
+private:
+    struct CachedManifest {
+        std::filesystem::file_time_type modified;
+        uintmax_t size = 0;
+        std::vector<Door> doors;
+        uint64_t fingerprint = 0;   // fingerprintDat151Manifest of the file and the presets
+    };
+
+    bool refreshPresets(std::string& response);
+    bool parseManifest(const std::string& text, std::vector<Door>& doors, std::string& response);
+    const CachedManifest* loadManifest(const std::string& path, std::string& response);
+    struct Connection {
+        int socket = -1;
+        std::string input;  // Received bytes not yet handled, at most a partial frame once served
+    };
+
+    bool serveConnection(Connection& connection);
+
+    std::string settingsPath;
+    std::filesystem::file_time_type settingsModified;
+    bool hasPresets = false;
+    std::vector<SoundPreset> presetList;  // Fingerprinted with manifests, as the export command does
+    PresetIndex presets;
+
+    // Parsed manifests of ExportFile requests, by path
+    std::unordered_map<std::string, CachedManifest> manifests;
+    bool useExportCache = false;
+    ExportCache exportCache;
+
+    std::string socketPath;
+    int listenSocket = -1;
+    bool stopRequested = false;
+};
+
+/**
+ * Connect to a running DoorDaemon
+ * @param socketPath Path of the daemon's socket file
+ * @return Connected socket, or -1 on failure
+ */
+int connectDoorDaemon(const std::string& socketPath);
+
+/**
+ * Close a socket returned by connectDoorDaemon
+ */
+void closeDoorDaemonConnection(int connection);
+
+/**
+ * Write one frame to a socket
+ * @return true if the whole frame was written, false otherwise
+ */
+bool writeDaemonFrame(int connection, uint8_t type, const std::string& payload);
+
+/**
+ * Read one frame from a socket
+ * @return true if a whole frame was read, false on end of stream, error or oversized frame
+ */
+bool readDaemonFrame(int connection, uint8_t& type, std::string& payload);
@@ -0,0 +1,75 @@
+#include "door_generator.h"
+#include <charconv>
+#include <iostream>
+
+namespace {
+    // Position and length of the last '#' run, length 0 if there is none
+    void findNumberRun(const std::string& pattern, size_t& position, size_t& length) {
+        size_t end = pattern.find_last_of('#');
+        if (end == std::string::npos) {
+            position = 0;
+            length = 0;
+            return;
+        }
+        size_t start = end;
+        while (start > 0 && pattern[start - 1] == '#') {
+            start--;
+        }
+        position = start;
+        length = end - start + 1;
+    }
+
+    // Write the name for number into out, reusing its storage
+    void formatName(const std::string& pattern, size_t position, size_t length, uint32_t number, std::string& out) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        size_t digitCount = static_cast<size_t>(result.ptr - digits);
+
+        out.assign(pattern, 0, position);
+        if (digitCount < length) {
+            out.append(length - digitCount, '0');
+        }
+        out.append(digits, digitCount);
+        out.append(pattern, position + length, std::string::npos);
+    }
+}
+
+bool isValidDoorPattern(const std::string& pattern) {
+    return pattern.find('#') != std::string::npos;
+}
+
+std::string formatDoorPatternName(const std::string& pattern, uint32_t number) {
+    size_t position, length;
+    findNumberRun(pattern, position, length);
+    if (length == 0) {
+        return pattern;
+    }
+    std::string name;
+    formatName(pattern, position, length, number, name);
+    return name;
+}
+
+bool generateDoors(const std::string& pattern, uint32_t first, uint32_t count,
+                   const SoundPreset& preset, std::vector<Door>& doors) {
+    size_t position, length;
+    findNumberRun(pattern, position, length);
+    if (length == 0) {
+        std::cerr << "Door pattern has no '#' for the door number: " << pattern << std::endl;
+        return false;
+    }
+    if (count > 0 && first > UINT32_MAX - (count - 1)) {
+        std::cerr << "Door number range overflows" << std::endl;
+        return false;
+    }
+
+    InternedString sounds(preset.sounds);
+    InternedString tuningParams(preset.tuningParams);
+
+    doors.reserve(doors.size() + count);
+    std::string name;
+    for (uint32_t i = 0; i < count; i++) {
+        formatName(pattern, position, length, first + i, name);
+        doors.emplace_back(name, sounds, tuningParams, preset.maxOcclusion);
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "doors.h"
+#include "settings_manager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Check if a name pattern contains a '#' run for the door number
+ * @param pattern Name pattern, e.g. "door_name_##"
+ * @return true if the pattern can be expanded, false otherwise
+ */
+bool isValidDoorPattern(const std::string& pattern);
+
+/**
+ * Format the name of one door of a pattern
+ * The last run of '#' is replaced by the number, zero-padded to the length
+ * of the run; numbers wider than the run are written in full.
+ * @param pattern Name pattern, e.g. "door_name_##"
+ * @param number Door number
+ * @return The door name, e.g. "door_name_07"
+ */
+std::string formatDoorPatternName(const std::string& pattern, uint32_t number);
+
+/**
+ * Generate a series of doors sharing a preset
+ * The preset values are interned once and shared by every generated door.
+ * @param pattern Name pattern, see formatDoorPatternName
+ * @param first First door number
+ * @param count Number of doors to generate
+ * @param preset Sounds, tuning parameters and max occlusion of the doors
+ * @param doors Receives the generated doors, appended in number order
+ * @return true if the doors were generated, false if the pattern is invalid
+ *         or the range overflows
+ */
+bool generateDoors(const std::string& pattern, uint32_t first, uint32_t count,
+                   const SoundPreset& preset, std::vector<Door>& doors);
@@ -0,0 +1,265 @@
+#include "door_history.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    const std::string EMPTY_LABEL;
+    const std::string IMPLICIT_LABEL = "Change";
+}
+
+DoorHistory::DoorHistory(DoorStore& store, size_t maxOperations)
+    : store(store), maxOperations(maxOperations > 0 ? maxOperations : 1) {
+    store.addListener(this);
+}
+
+DoorHistory::~DoorHistory() {
+    store.removeListener(this);
+}
+
+void DoorHistory::beginOperation(const std::string& label) {
+    if (depth++ == 0) {
+        undoStack.push_back(Operation{ label, {} });
+        redoStack.clear();
+    }
+}
+
+void DoorHistory::endOperation() {
+    if (depth == 0 || --depth > 0) {
+        return;
+    }
+    if (undoStack.back().records.empty()) {
+        undoStack.pop_back();
+    }
+    while (undoStack.size() > maxOperations) {
+        undoStack.pop_front();
+    }
+}
+
+void DoorHistory::cancelOperation() {
+    if (depth == 0) {
+        return;
+    }
+    depth = 0;
+    Operation operation = std::move(undoStack.back());
+    undoStack.pop_back();
+    revert(operation);
+}
+
+const std::string& DoorHistory::getUndoLabel() const {
+    return undoStack.empty() ? EMPTY_LABEL : undoStack.back().label;
+}
+
+const std::string& DoorHistory::getRedoLabel() const {
+    return redoStack.empty() ? EMPTY_LABEL : redoStack.back().label;
+}
+
+bool DoorHistory::undo() {
+    if (!canUndo()) {
+        return false;
+    }
+    Operation operation = std::move(undoStack.back());
+    undoStack.pop_back();
+    revert(operation);
+    redoStack.push_back(std::move(operation));
+    return true;
+}
+
+bool DoorHistory::redo() {
+    if (!canRedo()) {
+        return false;
+    }
+    Operation operation = std::move(redoStack.back());
+    redoStack.pop_back();
+    replay(operation);
+    undoStack.push_back(std::move(operation));
+    return true;
+}
+
+void DoorHistory::clear() {
+    undoStack.clear();
+    redoStack.clear();
+    depth = 0;
+}
+
+void DoorHistory::onDoorsInserted(const std::vector<size_t>& positions) {
+    if (applying || positions.empty()) {
+        return;
+    }
+    auto& records = currentOperation().records;
+
+    // Appending after every door inserted so far leaves their indices unchanged, so
+    // the positions can join the last insert, even past edits of earlier doors
+    Record* target = nullptr;
+    if (!records.empty()) {
+        Record& last = records.back();
+        if (last.kind == Record::Kind::Inserted && positions.front() > last.positions.back()) {
+            target = &last;
+        } else if (last.kind == Record::Kind::Updated && records.size() > 1 &&
+                   last.maxIndex < positions.front()) {
+            Record& previous = records[records.size() - 2];
+            if (previous.kind == Record::Kind::Inserted && positions.front() > previous.positions.back()) {
+                target = &previous;
+            }
+        }
+    }
+
+    if (!target) {
+        records.emplace_back();
+        target = &records.back();
+        target->kind = Record::Kind::Inserted;
+    }
+    target->positions.insert(target->positions.end(), positions.begin(), positions.end());
+}
+
+void DoorHistory::onDoorUpdated(size_t index, const Door& previous) {
+    if (applying) {
+        return;
+    }
+
+    const Door& current = store[index];
+    FieldDelta delta;
+    delta.index = index;
+    if (current.getName() != previous.getName()) {
+        delta.fields |= FIELD_NAME;
+        delta.name = previous.getName();
+    }
+    if (current.getInternedSounds() != previous.getInternedSounds()) {
+        delta.fields |= FIELD_SOUNDS;
+        delta.sounds = previous.getInternedSounds();
+    }
+    if (current.getInternedTuningParams() != previous.getInternedTuningParams()) {
+        delta.fields |= FIELD_TUNING_PARAMS;
+        delta.tuningParams = previous.getInternedTuningParams();
+    }
+    if (current.getMaxOcclusion() != previous.getMaxOcclusion()) {
+        delta.fields |= FIELD_MAX_OCCLUSION;
+        delta.maxOcclusion = previous.getMaxOcclusion();
+    }
+    if (delta.fields == 0) {
+        return;
+    }
+
+    auto& records = currentOperation().records;
+
+    // An edit before every inserted door is unaffected by the insert, so it can
+    // join the edits recorded before it (e.g. an import replacing existing doors)
+    Record* target = nullptr;
+    if (!records.empty()) {
+        Record& last = records.back();
+        if (last.kind == Record::Kind::Updated) {
+            target = &last;
+        } else if (last.kind == Record::Kind::Inserted && records.size() > 1 &&
+                   index < last.positions.front()) {
+            Record& before = records[records.size() - 2];
+            if (before.kind == Record::Kind::Updated) {
+                target = &before;
+            }
+        }
+    }
+
+    if (!target) {
+        records.emplace_back();
+        target = &records.back();
+        target->kind = Record::Kind::Updated;
+    }
+    target->maxIndex = std::max(target->maxIndex, index);
+    target->deltas.push_back(std::move(delta));
+}
+
+void DoorHistory::onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) {
+    if (applying || positions.empty()) {
+        return;
+    }
+    auto& records = currentOperation().records;
+    records.emplace_back();
+    Record& record = records.back();
+    record.kind = Record::Kind::Removed;
+    record.positions = positions;
+    record.doors = removed;
+}
+
+DoorHistory::Operation& DoorHistory::currentOperation() {
+    if (depth == 0) {
+        // A change outside of any operation is an operation on its own
+        undoStack.push_back(Operation{ IMPLICIT_LABEL, {} });
+        redoStack.clear();
+        while (undoStack.size() > maxOperations) {
+            undoStack.pop_front();
+        }
+    }
+    return undoStack.back();
+}
+
+void DoorHistory::apply(Record& record, bool reverse) {
+    switch (record.kind) {
+        case Record::Kind::Inserted:
+            record.doors.reserve(record.positions.size());
+            for (size_t position : record.positions) {
+                record.doors.push_back(store[position]);
+            }
+            store.removeDoors(record.positions);
+            record.kind = Record::Kind::Removed;
+            break;
+
+        case Record::Kind::Removed:
+            store.insertDoors(record.positions, std::move(record.doors));
+            record.doors.clear();
+            record.doors.shrink_to_fit();
+            record.kind = Record::Kind::Inserted;
+            break;
+
+        case Record::Kind::Updated: {
+            // Swapping the stored fields with the door's makes the delta point the other way
+            auto swapFields = [this](FieldDelta& delta) {
+                Door door = store[delta.index];
+                if (delta.fields & FIELD_NAME) {
+                    std::string name = door.getName();
+                    door.setName(delta.name);
+                    delta.name = std::move(name);
+                }
+                if (delta.fields & FIELD_SOUNDS) {
+                    InternedString sounds = door.getInternedSounds();
+                    door.setSounds(delta.sounds);
+                    delta.sounds = sounds;
+                }
+                if (delta.fields & FIELD_TUNING_PARAMS) {
+                    InternedString tuningParams = door.getInternedTuningParams();
+                    door.setTuningParams(delta.tuningParams);
+                    delta.tuningParams = tuningParams;
+                }
+                if (delta.fields & FIELD_MAX_OCCLUSION) {
+                    float maxOcclusion = door.getMaxOcclusion();
+                    door.setMaxOcclusion(delta.maxOcclusion);
+                    delta.maxOcclusion = maxOcclusion;
+                }
+                store.updateDoor(delta.index, door);
+            };
+            if (reverse) {
+                for (auto it = record.deltas.rbegin(); it != record.deltas.rend(); ++it) {
+                    swapFields(*it);
+                }
+            } else {
+                for (auto& delta : record.deltas) {
+                    swapFields(delta);
+                }
+            }
+            break;
+        }
+    }
+}
+
+void DoorHistory::revert(Operation& operation) {
+    applying = true;
+    for (auto it = operation.records.rbegin(); it != operation.records.rend(); ++it) {
+        apply(*it, true);
+    }
+    applying = false;
+}
+
+void DoorHistory::replay(Operation& operation) {
+    applying = true;
+    for (auto& record : operation.records) {
+        apply(record, false);
+    }
+    applying = false;
+}
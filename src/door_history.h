@@ -0,0 +1,115 @@
+#pragma once
+
+#include "door_store.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * Undo/redo journal for a DoorStore
+ * Changes are recorded through DoorStoreListener notifications and grouped
+ * into operations. Only what changed is kept: the indices of inserted doors,
+ * the changed fields of edited doors and the removed doors themselves, so an
+ * operation costs memory proportional to its size, not to the project.
+ */
+class DoorHistory : public DoorStoreListener {
+public:
+    static constexpr size_t DEFAULT_MAX_OPERATIONS = 100;
+
+    explicit DoorHistory(DoorStore& store, size_t maxOperations = DEFAULT_MAX_OPERATIONS);
+    ~DoorHistory() override;
+    DoorHistory(const DoorHistory&) = delete;
+    DoorHistory& operator=(const DoorHistory&) = delete;
+
+    /**
+     * Group the following changes into one undoable operation
+     * Calls can be nested, only the outermost pair defines the operation.
+     * Changes made outside of an operation are recorded one by one.
+     * @param label Name shown for the operation, e.g. "Delete doors"
+     */
+    void beginOperation(const std::string& label);
+
+    /**
+     * Close the operation opened by beginOperation
+     */
+    void endOperation();
+
+    /**
+     * Revert the changes of the open operation and discard it
+     */
+    void cancelOperation();
+
+    bool canUndo() const { return depth == 0 && !undoStack.empty(); }
+    bool canRedo() const { return depth == 0 && !redoStack.empty(); }
+    const std::string& getUndoLabel() const;
+    const std::string& getRedoLabel() const;
+
+    /**
+     * Revert the last operation
+     * @return true if an operation was undone, false otherwise
+     */
+    bool undo();
+
+    /**
+     * Apply the last undone operation again
+     * @return true if an operation was redone, false otherwise
+     */
+    bool redo();
+
+    /**
+     * Forget every recorded operation
+     */
+    void clear();
+
+    void onDoorsInserted(const std::vector<size_t>& positions) override;
+    void onDoorUpdated(size_t index, const Door& previous) override;
+    void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) override;
+
+private:
+    // Fields of a door that differ between two states
+    enum FieldMask : uint8_t {
+        FIELD_NAME = 1 << 0,
+        FIELD_SOUNDS = 1 << 1,
+        FIELD_TUNING_PARAMS = 1 << 2,
+        FIELD_MAX_OCCLUSION = 1 << 3
+    };
+
+    // The other value of the changed fields of one door, swapped with the store on undo and redo
+    struct FieldDelta {
+        size_t index = 0;
+        uint8_t fields = 0;
+        std::string name;               // Only set when FIELD_NAME is
+        InternedString sounds;
+        InternedString tuningParams;
+        float maxOcclusion = 0.0f;
+    };
+
+    // One step of an operation; undoing it turns an insert into a removal and back
+    struct Record {
+        enum class Kind { Inserted, Removed, Updated };
+        Kind kind = Kind::Updated;
+        std::vector<size_t> positions;  // Inserted/Removed: door indices, ascending
+        std::vector<Door> doors;        // Removed: the removed doors
+        std::vector<FieldDelta> deltas; // Updated
+        size_t maxIndex = 0;            // Updated: largest edited index
+    };
+
+    struct Operation {
+        std::string label;
+        std::vector<Record> records;
+    };
+
+    Operation& currentOperation();
+    void apply(Record& record, bool reverse);
+    void revert(Operation& operation);
+    void replay(Operation& operation);
+
+    DoorStore& store;
+    size_t maxOperations;
+    std::deque<Operation> undoStack;
+    std::deque<Operation> redoStack;
+    int depth = 0;                  // Nesting of beginOperation calls
+    bool applying = false;          // Set while undo/redo changes the store
+};
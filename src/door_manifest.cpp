@@ -0,0 +1,165 @@
+#include "door_manifest.h"
+#include "door_store.h"
+#include "mapped_file.h"
+#include <iostream>
+#include <istream>
+
+bool parseDoorManifestEntry(const nlohmann::json& entry, const PresetIndex& presets,
+                            Door& door, std::string& error) {
+    if (!entry.is_object()) {
+        error = "entry is not an object";
+        return false;
+    }
+
+    auto name = entry.find("name");
+    if (name == entry.end() || !name->is_string() || name->get_ref<const std::string&>().empty()) {
+        error = "missing door name";
+        return false;
+    }
+
+    // Start from the preset, if any, then apply the explicit fields
+    InternedString sounds;
+    InternedString tuningParams;
+    float maxOcclusion = 0.7f;
+    bool hasSounds = false;
+    bool hasTuningParams = false;
+
+    auto preset = entry.find("preset");
+    if (preset != entry.end()) {
+        if (!preset->is_string()) {
+            error = "preset is not a string";
+            return false;
+        }
+        const PresetIndex::Entry* values = presets.find(preset->get_ref<const std::string&>());
+        if (!values) {
+            error = "unknown preset '" + preset->get<std::string>() + "'";
+            return false;
+        }
+        sounds = values->sounds;
+        tuningParams = values->tuningParams;
+        maxOcclusion = values->maxOcclusion;
+        hasSounds = true;
+        hasTuningParams = true;
+    }
+
+    auto field = entry.find("sounds");
+    if (field != entry.end()) {
+        if (!field->is_string()) {
+            error = "sounds is not a string";
+            return false;
+        }
+        sounds = InternedString(field->get_ref<const std::string&>());
+        hasSounds = true;
+    }
+    field = entry.find("tuningParams");
+    if (field != entry.end()) {
+        if (!field->is_string()) {
+            error = "tuningParams is not a string";
+            return false;
+        }
+        tuningParams = InternedString(field->get_ref<const std::string&>());
+        hasTuningParams = true;
+    }
+    field = entry.find("maxOcclusion");
+    if (field != entry.end()) {
+        if (!field->is_number()) {
+            error = "maxOcclusion is not a number";
+            return false;
+        }
+        maxOcclusion = field->get<float>();
+    }
+
+    if (!hasSounds || !hasTuningParams) {
+        error = "door needs a preset or both sounds and tuningParams";
+        return false;
+    }
+
+    door = Door(name->get<std::string>(), sounds, tuningParams, maxOcclusion);
+    return true;
+}
+
+bool parseDoorManifest(const char* begin, const char* end, const PresetIndex& presets,
+                       std::vector<Door>& doors, std::vector<std::string>& errors) {
+    nlohmann::json manifest = nlohmann::json::parse(begin, end, nullptr, false);
+    if (manifest.is_discarded()) {
+        errors.push_back("invalid JSON");
+        return false;
+    }
+
+    const nlohmann::json* entries = &manifest;
+    if (manifest.is_object()) {
+        auto it = manifest.find("doors");
+        entries = it != manifest.end() ? &*it : nullptr;
+    }
+    if (!entries || !entries->is_array()) {
+        errors.push_back("manifest must be an array of doors or an object with a \"doors\" array");
+        return false;
+    }
+
+    DoorStore store;
+    store.reserve(entries->size());
+    bool valid = true;
+    std::string error;
+    for (size_t i = 0; i < entries->size(); i++) {
+        Door door;
+        if (!parseDoorManifestEntry((*entries)[i], presets, door, error)) {
+            errors.push_back("door " + std::to_string(i) + ": " + error);
+            valid = false;
+            continue;
+        }
+        store.upsertDoor(door);
+    }
+    if (!valid) {
+        return false;
+    }
+
+    doors = store.getDoors();
+    return true;
+}
+
+bool readDoorManifest(const std::string& path, const PresetIndex& presets, std::vector<Door>& doors) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open manifest: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> errors;
+    if (!parseDoorManifest(file.getData(), file.getData() + file.getSize(), presets, doors, errors)) {
+        for (const auto& error : errors) {
+            std::cerr << path << ": " << error << std::endl;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool readDoorLines(std::istream& input, const std::string& sourceName, const PresetIndex& presets,
+                   const std::function<bool(Door& door)>& visitor) {
+    bool valid = true;
+    std::string line;
+    std::string error;
+    Door door;
+    for (size_t lineNumber = 1; std::getline(input, line); lineNumber++) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        nlohmann::json entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded()) {
+            error = "invalid JSON";
+        } else if (parseDoorManifestEntry(entry, presets, door, error)) {
+            if (!visitor(door)) {
+                return false;
+            }
+            continue;
+        }
+        std::cerr << sourceName << ":" << lineNumber << ": " << error << std::endl;
+        valid = false;
+    }
+    if (input.bad()) {
+        std::cerr << "Error reading " << sourceName << std::endl;
+        return false;
+    }
+    return valid;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "doors.h"
+#include "preset_index.h"
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * Convert one manifest entry to a door
+ * An entry either has the Door::toJson shape (name, sounds, tuningParams,
+ * maxOcclusion) or names a preset: {"name": "...", "preset": "..."}.
+ * Fields given next to a preset override the preset's values.
+ * @param entry JSON object describing the door
+ * @param presets Presets that entries may refer to
+ * @param door Receives the door
+ * @param error Receives a description of the problem on failure
+ * @return true if the entry was valid, false otherwise
+ */
+bool parseDoorManifestEntry(const nlohmann::json& entry, const PresetIndex& presets,
+                            Door& door, std::string& error);
+
+/**
+ * Parse the text of a door manifest
+ * A manifest is a JSON array of entries, or an object with a "doors" array.
+ * When a name appears twice, the last entry wins.
+ * @param begin First character of the manifest
+ * @param end One past the last character of the manifest
+ * @param presets Presets that entries may refer to
+ * @param doors Receives the doors in manifest order
+ * @param errors Receives one message per problem found
+ * @return true if the whole manifest was valid, false otherwise
+ */
+bool parseDoorManifest(const char* begin, const char* end, const PresetIndex& presets,
+                       std::vector<Door>& doors, std::vector<std::string>& errors);
+
+/**
+ * Read a door manifest file, see parseDoorManifest
+ * Problems are reported on std::cerr.
+ * @param path Path to the manifest
+ * @param presets Presets that entries may refer to
+ * @param doors Receives the doors in manifest order
+ * @return true if the whole manifest was valid, false otherwise
+ */
+bool readDoorManifest(const std::string& path, const PresetIndex& presets, std::vector<Door>& doors);
+
+/**
+ * Read doors from a JSON lines stream, one manifest entry per line
+ * Doors are handed over as soon as their line is parsed, so the stream can
+ * be processed without holding it in memory. Invalid lines are reported
+ * with their line number and skipped, blank lines are ignored.
+ * @param input Stream to read, e.g. std::cin
+ * @param sourceName Name of the stream used in error messages
+ * @param presets Presets that entries may refer to
+ * @param visitor Called for each door, returns false to stop reading
+ * @return true if every line was valid and the visitor never stopped, false otherwise
+ */
+bool readDoorLines(std::istream& input, const std::string& sourceName, const PresetIndex& presets,
+                   const std::function<bool(Door& door)>& visitor);
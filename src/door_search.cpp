@@ -0,0 +1,280 @@
+#include "door_search.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    std::string toLowerAscii(std::string_view str) {
+        std::string lower(str);
+        for (char& c : lower) {
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        return lower;
+    }
+
+    uint32_t packGram(const char* gram) {
+        return static_cast<uint32_t>(static_cast<unsigned char>(gram[0])) |
+               static_cast<uint32_t>(static_cast<unsigned char>(gram[1])) << 8 |
+               static_cast<uint32_t>(static_cast<unsigned char>(gram[2])) << 16;
+    }
+
+    // Distinct trigrams of a lowercase string, ascending
+    std::vector<uint32_t> collectGrams(std::string_view str) {
+        std::vector<uint32_t> result;
+        if (str.size() < 3) {
+            return result;
+        }
+        result.reserve(str.size() - 2);
+        for (size_t i = 0; i + 3 <= str.size(); i++) {
+            result.push_back(packGram(str.data() + i));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+}
+
+DoorSearchIndex::DoorSearchIndex(DoorStore& store) : store(store) {
+    idsByIndex.reserve(store.size());
+    for (size_t i = 0; i < store.size(); i++) {
+        idsByIndex.push_back(addEntry(store[i]));
+    }
+    reindexFrom(0);
+    store.addListener(this);
+}
+
+DoorSearchIndex::~DoorSearchIndex() {
+    store.removeListener(this);
+}
+
+void DoorSearchIndex::search(std::string_view query, std::vector<size_t>& results) {
+    std::string lowerQuery = toLowerAscii(query);
+    results.clear();
+
+    // Few distinct values exist, so test each one once
+    std::vector<const std::string*> matchedValues;
+    for (const auto& [value, lower] : values) {
+        if (lower.find(lowerQuery) != std::string::npos) {
+            matchedValues.push_back(value);
+        }
+    }
+    std::sort(matchedValues.begin(), matchedValues.end());
+    auto isMatched = [&](const std::string* value) {
+        return std::binary_search(matchedValues.begin(), matchedValues.end(), value);
+    };
+
+    // Typing more characters can only narrow the previous results down,
+    // which beats the index when few results are left
+    if (hasLastResults && lastRevision == store.getRevision() &&
+        lowerQuery.find(lastQuery) != std::string::npos &&
+        (lowerQuery.size() < GRAM_LENGTH || lastResults.size() <= INCREMENTAL_LIMIT)) {
+        for (size_t index : lastResults) {
+            const Entry& entry = entries[idsByIndex[index]];
+            if (entry.lowerName.find(lowerQuery) != std::string::npos ||
+                isMatched(entry.sounds) || isMatched(entry.tuningParams)) {
+                results.push_back(index);
+            }
+        }
+    } else {
+        std::vector<size_t> nameMatches;
+        searchNames(lowerQuery, nameMatches);
+
+        if (matchedValues.empty()) {
+            results = std::move(nameMatches);
+        } else {
+            // Merge the name matches with the doors using a matching value
+            size_t next = 0;
+            for (size_t index = 0; index < idsByIndex.size(); index++) {
+                const Entry& entry = entries[idsByIndex[index]];
+                bool nameMatch = next < nameMatches.size() && nameMatches[next] == index;
+                if (nameMatch) {
+                    next++;
+                }
+                if (nameMatch || isMatched(entry.sounds) || isMatched(entry.tuningParams)) {
+                    results.push_back(index);
+                }
+            }
+        }
+    }
+
+    lastQuery = std::move(lowerQuery);
+    lastRevision = store.getRevision();
+    lastResults = results;
+    hasLastResults = true;
+}
+
+void DoorSearchIndex::onDoorsInserted(const std::vector<size_t>& positions) {
+    if (positions.empty()) {
+        return;
+    }
+    std::vector<DoorId> added;
+    added.reserve(positions.size());
+    for (size_t position : positions) {
+        added.push_back(addEntry(store[position]));
+    }
+
+    // Merge from the back so every id moves once
+    size_t read = idsByIndex.size();
+    size_t next = positions.size();
+    idsByIndex.resize(idsByIndex.size() + positions.size());
+    for (size_t write = idsByIndex.size(); write-- > positions.front();) {
+        if (next > 0 && positions[next - 1] == write) {
+            idsByIndex[write] = added[--next];
+        } else {
+            idsByIndex[write] = idsByIndex[--read];
+        }
+    }
+    reindexFrom(positions.front());
+}
+
+void DoorSearchIndex::onDoorUpdated(size_t index, const Door& previous) {
+    DoorId id = idsByIndex[index];
+    Entry& entry = entries[id];
+    const Door& door = store[index];
+
+    if (door.getName() != previous.getName()) {
+        unindexName(id);
+        entry.lowerName = toLowerAscii(door.getName());
+        indexName(id);
+    }
+
+    entry.sounds = &door.getSounds();
+    entry.tuningParams = &door.getTuningParams();
+    for (const std::string* value : { entry.sounds, entry.tuningParams }) {
+        if (values.find(value) == values.end()) {
+            values.emplace(value, toLowerAscii(*value));
+        }
+    }
+}
+
+void DoorSearchIndex::onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>&) {
+    if (positions.empty()) {
+        return;
+    }
+
+    size_t write = 0;
+    size_t next = 0;
+    for (size_t read = 0; read < idsByIndex.size(); read++) {
+        DoorId id = idsByIndex[read];
+        if (next < positions.size() && positions[next] == read) {
+            unindexName(id);
+            entries[id] = Entry();
+            indexById[id] = DoorStore::npos;
+            freeIds.push_back(id);
+            next++;
+            continue;
+        }
+        idsByIndex[write++] = id;
+    }
+    idsByIndex.resize(write);
+    reindexFrom(positions.front());
+}
+
+DoorSearchIndex::DoorId DoorSearchIndex::addEntry(const Door& door) {
+    DoorId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<DoorId>(entries.size());
+        entries.emplace_back();
+        indexById.push_back(DoorStore::npos);
+    }
+    Entry& entry = entries[id];
+    entry.lowerName = toLowerAscii(door.getName());
+    entry.sounds = &door.getSounds();
+    entry.tuningParams = &door.getTuningParams();
+
+    for (const std::string* value : { entries[id].sounds, entries[id].tuningParams }) {
+        if (values.find(value) == values.end()) {
+            values.emplace(value, toLowerAscii(*value));
+        }
+    }
+
+    indexName(id);
+    return id;
+}
+
+void DoorSearchIndex::indexName(DoorId id) {
+    for (uint32_t gram : collectGrams(entries[id].lowerName)) {
+        auto& postings = grams[gram];
+        // Fresh ids are the largest, so this is an append unless an id is reused
+        postings.insert(std::lower_bound(postings.begin(), postings.end(), id), id);
+    }
+}
+
+void DoorSearchIndex::unindexName(DoorId id) {
+    for (uint32_t gram : collectGrams(entries[id].lowerName)) {
+        auto it = grams.find(gram);
+        if (it == grams.end()) {
+            continue;
+        }
+        auto& postings = it->second;
+        auto pos = std::lower_bound(postings.begin(), postings.end(), id);
+        if (pos != postings.end() && *pos == id) {
+            postings.erase(pos);
+        }
+        if (postings.empty()) {
+            grams.erase(it);
+        }
+    }
+}
+
+void DoorSearchIndex::searchNames(std::string_view lowerQuery, std::vector<size_t>& results) const {
+    results.clear();
+
+    // Too short for a trigram, check the names directly
+    if (lowerQuery.size() < GRAM_LENGTH) {
+        for (size_t index = 0; index < idsByIndex.size(); index++) {
+            if (entries[idsByIndex[index]].lowerName.find(lowerQuery) != std::string::npos) {
+                results.push_back(index);
+            }
+        }
+        return;
+    }
+
+    // Intersect the posting lists, smallest first
+    std::vector<const std::vector<DoorId>*> lists;
+    for (uint32_t gram : collectGrams(lowerQuery)) {
+        auto it = grams.find(gram);
+        if (it == grams.end()) {
+            return;
+        }
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+        return a->size() < b->size();
+    });
+
+    std::vector<DoorId> candidates = *lists.front();
+    std::vector<DoorId> scratch;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); i++) {
+        const auto& list = *lists[i];
+        if (candidates.size() * 16 < list.size()) {
+            // Much shorter than the list, binary search each candidate instead of merging
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](DoorId id) {
+                return !std::binary_search(list.begin(), list.end(), id);
+            }), candidates.end());
+        } else {
+            scratch.clear();
+            std::set_intersection(candidates.begin(), candidates.end(),
+                                  list.begin(), list.end(), std::back_inserter(scratch));
+            candidates.swap(scratch);
+        }
+    }
+
+    // Sharing every trigram does not guarantee the substring is present
+    for (DoorId id : candidates) {
+        if (entries[id].lowerName.find(lowerQuery) != std::string::npos) {
+            results.push_back(indexById[id]);
+        }
+    }
+    std::sort(results.begin(), results.end());
+}
+
+void DoorSearchIndex::reindexFrom(size_t index) {
+    for (size_t i = index; i < idsByIndex.size(); i++) {
+        indexById[idsByIndex[i]] = i;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "door_store.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Incremental substring search over the doors of a DoorStore
+ * Door names are indexed by their lowercase trigrams, so a query only
+ * verifies the doors sharing every trigram of the query instead of scanning
+ * every name. Sounds and tuning values are interned, so they are matched
+ * once per distinct value and doors are then selected by pointer.
+ * The index follows the store through DoorStoreListener notifications.
+ */
+class DoorSearchIndex : public DoorStoreListener {
+public:
+    explicit DoorSearchIndex(DoorStore& store);
+    ~DoorSearchIndex() override;
+    DoorSearchIndex(const DoorSearchIndex&) = delete;
+    DoorSearchIndex& operator=(const DoorSearchIndex&) = delete;
+
+    /**
+     * Find the doors whose name, sounds or tuning parameters contain a text
+     * Matching is ASCII case-insensitive. When the query extends the previous
+     * one and the store did not change, only the previous results are checked.
+     * @param query Text to look for, must not be empty
+     * @param results Receives the matching door indices, ascending
+     */
+    void search(std::string_view query, std::vector<size_t>& results);
+
+    void onDoorsInserted(const std::vector<size_t>& positions) override;
+    void onDoorUpdated(size_t index, const Door& previous) override;
+    void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) override;
+
+private:
+    using DoorId = uint32_t;  // Stable across index shifts, reused once the door is removed
+
+    struct Entry {
+        std::string lowerName;
+        const std::string* sounds = nullptr;        // Interned, compared by address
+        const std::string* tuningParams = nullptr;
+    };
+
+    static constexpr size_t GRAM_LENGTH = 3;
+    static constexpr size_t INCREMENTAL_LIMIT = 4096;  // Max previous results refined without the index
+
+    DoorId addEntry(const Door& door);
+    void indexName(DoorId id);
+    void unindexName(DoorId id);
+    void searchNames(std::string_view lowerQuery, std::vector<size_t>& results) const;
+    void reindexFrom(size_t index);
+
+    DoorStore& store;
+    std::vector<Entry> entries;                                 // By DoorId, left empty until the id is reused
+    std::vector<DoorId> idsByIndex;                             // Store index -> DoorId
+    std::vector<size_t> indexById;                              // DoorId -> store index, npos once removed
+    std::vector<DoorId> freeIds;                                // Ids of removed doors, handed out again first
+    std::unordered_map<uint32_t, std::vector<DoorId>> grams;    // Packed trigram -> ascending DoorIds
+
+    std::unordered_map<const std::string*, std::string> values;  // Distinct sounds/tuning value -> lowercase copy
+
+    // Previous search, reused while the user keeps typing
+    std::string lastQuery;
+    uint64_t lastRevision = 0;
+    std::vector<size_t> lastResults;
+    bool hasLastResults = false;
+};
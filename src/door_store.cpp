@@ -0,0 +1,203 @@
+#include "door_store.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+size_t DoorStore::findDoor(std::string_view name) const {
+    auto range = nameIndex.equal_range(hashName(name));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (doors[it->second].getName() == name) {
+            return it->second;
+        }
+    }
+    return npos;
+}
+
+bool DoorStore::hasDoor(std::string_view name, size_t ignoredIndex) const {
+    auto range = nameIndex.equal_range(hashName(name));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second != ignoredIndex && doors[it->second].getName() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DoorStore::addDoor(const Door& door) {
+    doors.push_back(door);
+    indexDoor(doors.size() - 1);
+    revision++;
+
+    if (!listeners.empty()) {
+        std::vector<size_t> positions{ doors.size() - 1 };
+        for (auto* listener : listeners) {
+            listener->onDoorsInserted(positions);
+        }
+    }
+}
+
+void DoorStore::addDoors(std::vector<Door> newDoors) {
+    if (newDoors.empty()) {
+        return;
+    }
+
+    // Grow geometrically, imports append batch after batch
+    size_t first = doors.size();
+    if (first + newDoors.size() > doors.capacity()) {
+        reserve(std::max(first + newDoors.size(), doors.capacity() * 2));
+    }
+    for (auto& door : newDoors) {
+        doors.push_back(std::move(door));
+        indexDoor(doors.size() - 1);
+    }
+    revision++;
+
+    if (!listeners.empty()) {
+        std::vector<size_t> positions(doors.size() - first);
+        for (size_t i = 0; i < positions.size(); i++) {
+            positions[i] = first + i;
+        }
+        for (auto* listener : listeners) {
+            listener->onDoorsInserted(positions);
+        }
+    }
+}
+
+void DoorStore::insertDoors(const std::vector<size_t>& positions, std::vector<Door> newDoors) {
+    if (positions.empty() || positions.size() != newDoors.size() ||
+        positions.back() >= doors.size() + newDoors.size()) {
+        return;
+    }
+
+    // Merge into a new vector, each existing door moves once
+    size_t first = positions.front();
+    size_t total = doors.size() + newDoors.size();
+    std::vector<Door> merged;
+    merged.reserve(total);
+    merged.insert(merged.end(), std::make_move_iterator(doors.begin()),
+                  std::make_move_iterator(doors.begin() + first));
+    size_t next = 0;
+    size_t old = first;
+    while (merged.size() < total) {
+        if (next < positions.size() && positions[next] == merged.size()) {
+            merged.push_back(std::move(newDoors[next++]));
+        } else {
+            merged.push_back(std::move(doors[old++]));
+        }
+    }
+    doors = std::move(merged);
+
+    // Everything from the first inserted door onwards moved, index it again
+    for (auto it = nameIndex.begin(); it != nameIndex.end();) {
+        if (it->second >= first) {
+            it = nameIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (size_t index = first; index < doors.size(); index++) {
+        indexDoor(index);
+    }
+    revision++;
+
+    for (auto* listener : listeners) {
+        listener->onDoorsInserted(positions);
+    }
+}
+
+bool DoorStore::updateDoor(size_t index, const Door& door) {
+    if (index >= doors.size()) {
+        return false;
+    }
+
+    bool renamed = doors[index].getName() != door.getName();
+    if (renamed) {
+        unindexDoor(index);
+    }
+    // Copy first: door may alias the stored element
+    Door previous = listeners.empty() ? Door() : doors[index];
+    doors[index] = door;
+    if (renamed) {
+        indexDoor(index);
+    }
+    revision++;
+
+    for (auto* listener : listeners) {
+        listener->onDoorUpdated(index, previous);
+    }
+    return true;
+}
+
+size_t DoorStore::removeDoors(std::vector<size_t> indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    indices.erase(std::lower_bound(indices.begin(), indices.end(), doors.size()), indices.end());
+    if (indices.empty()) {
+        return 0;
+    }
+
+    std::vector<Door> removed;
+    if (!listeners.empty()) {
+        removed.reserve(indices.size());
+    }
+
+    // Single compaction pass, every kept door moves at most once
+    size_t write = indices.front();
+    size_t next = 0;
+    for (size_t read = indices.front(); read < doors.size(); read++) {
+        if (next < indices.size() && indices[next] == read) {
+            unindexDoor(read);
+            if (!listeners.empty()) {
+                removed.push_back(std::move(doors[read]));
+            }
+            next++;
+            continue;
+        }
+        if (write != read) {
+            doors[write] = std::move(doors[read]);
+        }
+        write++;
+    }
+    doors.erase(doors.begin() + write, doors.end());
+    revision++;
+
+    // Each remaining door moved down by the number of removed doors before it
+    for (auto& entry : nameIndex) {
+        if (entry.second > indices.front()) {
+            entry.second -= std::lower_bound(indices.begin(), indices.end(), entry.second) - indices.begin();
+        }
+    }
+
+    for (auto* listener : listeners) {
+        listener->onDoorsRemoved(indices, removed);
+    }
+    return indices.size();
+}
+
+size_t DoorStore::upsertDoor(const Door& door) {
+    size_t index = findDoor(door.getName());
+    if (index != npos) {
+        updateDoor(index, door);
+        return index;
+    }
+    addDoor(door);
+    return doors.size() - 1;
+}
+
+void DoorStore::indexDoor(size_t index) {
+    nameIndex.emplace(hashName(doors[index].getName()), index);
+}
+
+void DoorStore::unindexDoor(size_t index) {
+    auto range = nameIndex.equal_range(hashName(doors[index].getName()));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == index) {
+            nameIndex.erase(it);
+            return;
+        }
+    }
+}
+
+void DoorStore::removeListener(DoorStoreListener* listener) {
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "doors.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Receives notifications about changes made to a DoorStore
+ * Lets caches and indexes over the door list update incrementally instead
+ * of being rebuilt every frame.
+ */
+class DoorStoreListener {
+public:
+    virtual ~DoorStoreListener() = default;
+
+    /**
+     * Doors were inserted
+     * @param positions Indices of the new doors after insertion, ascending
+     */
+    virtual void onDoorsInserted(const std::vector<size_t>& positions) = 0;
+
+    /**
+     * A door was replaced in place
+     * @param index Index of the door
+     * @param previous Door before the change
+     */
+    virtual void onDoorUpdated(size_t index, const Door& previous) = 0;
+
+    /**
+     * Doors were removed
+     * @param positions Indices of the removed doors before removal, ascending
+     * @param removed The removed doors, in the same order
+     */
+    virtual void onDoorsRemoved(const std::vector<size_t>& positions, const std::vector<Door>& removed) = 0;
+};
+
+/**
+ * Ordered collection of doors with a name index
+ * Every mutation keeps the name -> index hash index in sync with the door
+ * vector, so name lookups and duplicate checks are O(1).
+ */
+class DoorStore {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    const std::vector<Door>& getDoors() const { return doors; }
+    const Door& operator[](size_t index) const { return doors[index]; }
+    size_t size() const { return doors.size(); }
+    bool empty() const { return doors.empty(); }
+
+    /**
+     * Counter incremented by every change to the store
+     * Lets callers cache results derived from the doors and detect when
+     * they are out of date with a single comparison.
+     */
+    uint64_t getRevision() const { return revision; }
+
+    /**
+     * Find the index of the door with the given name
+     * @param name Name to look for
+     * @return Index of the door, or npos if there is none
+     */
+    size_t findDoor(std::string_view name) const;
+
+    /**
+     * Check if a door with the given name exists
+     * @param name Name to check
+     * @param ignoredIndex Index of a door to skip, e.g. the one being edited
+     * @return true if another door with this name exists, false otherwise
+     */
+    bool hasDoor(std::string_view name, size_t ignoredIndex = npos) const;
+
+    /**
+     * Append a door at the end of the list
+     */
+    void addDoor(const Door& door);
+
+    /**
+     * Append several doors at the end of the list
+     * Storage is reserved once and listeners get a single notification.
+     * Names are not checked, callers filter out duplicates beforehand.
+     */
+    void addDoors(std::vector<Door> newDoors);
+
+    /**
+     * Insert doors so they end up at the given indices
+     * Used to put removed doors back in place.
+     * @param positions Final index of each door, ascending
+     * @param newDoors Doors to insert, in the same order
+     */
+    void insertDoors(const std::vector<size_t>& positions, std::vector<Door> newDoors);
+
+    /**
+     * Replace the door at a specific index
+     * @return true if the index was valid, false otherwise
+     */
+    bool updateDoor(size_t index, const Door& door);
+
+    /**
+     * Remove several doors at once
+     * The remaining doors are compacted in a single pass, so removing k doors
+     * costs O(n) instead of O(n * k) for k separate removals.
+     * @param indices Indices of the doors to remove, in any order; duplicates
+     *                and out of range indices are ignored
+     * @return Number of doors removed
+     */
+    size_t removeDoors(std::vector<size_t> indices);
+
+    /**
+     * Replace the door with the same name, or append it if there is none
+     * @return Index of the inserted or replaced door
+     */
+    size_t upsertDoor(const Door& door);
+
+    void reserve(size_t count) { doors.reserve(count); nameIndex.reserve(count); }
+
+    /**
+     * Register a listener notified after every change
+     * The listener must outlive the store or be removed first.
+     */
+    void addListener(DoorStoreListener* listener) { listeners.push_back(listener); }
+    void removeListener(DoorStoreListener* listener);
+
+private:
+    using NameIndex = std::unordered_multimap<size_t, size_t>;
+
+    static size_t hashName(std::string_view name) { return std::hash<std::string_view>()(name); }
+    void indexDoor(size_t index);
+    void unindexDoor(size_t index);
+
+    std::vector<Door> doors;
+    NameIndex nameIndex;  // Hash of the door name -> index in doors
+    std::vector<DoorStoreListener*> listeners;
+    uint64_t revision = 0;
+};
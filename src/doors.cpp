@@ -1,4 +1,5 @@
 #include "doors.h"
+#include <utility>
 
 Door::Door(const std::string& name, const std::string& sounds, 
            const std::string& tuningParams, float maxOcclusion)
@@ -8,11 +9,19 @@ Door::Door(const std::string& name, const std::string& sounds,
     , maxOcclusion(maxOcclusion)
 {}
 
+Door::Door(std::string name, InternedString sounds,
+           InternedString tuningParams, float maxOcclusion)
+    : name(std::move(name))
+    , sounds(sounds)
+    , tuningParams(tuningParams)
+    , maxOcclusion(maxOcclusion)
+{}
+
 nlohmann::json Door::toJson() const {
     nlohmann::json j;
     j["name"] = name;
-    j["sounds"] = sounds;
-    j["tuningParams"] = tuningParams;
+    j["sounds"] = sounds.str();
+    j["tuningParams"] = tuningParams.str();
     j["maxOcclusion"] = maxOcclusion;
     return j;
 }
@@ -20,8 +29,8 @@ nlohmann::json Door::toJson() const {
 Door Door::fromJson(const nlohmann::json& j) {
     Door door;
     door.name = j["name"].get<std::string>();
-    door.sounds = j["sounds"].get<std::string>();
-    door.tuningParams = j["tuningParams"].get<std::string>();
+    door.sounds = InternedString(j["sounds"].get<std::string>());
+    door.tuningParams = InternedString(j["tuningParams"].get<std::string>());
     door.maxOcclusion = j["maxOcclusion"].get<float>();
     return door;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "string_pool.h"
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -9,17 +10,25 @@ public:
     Door() = default;
     Door(const std::string& name, const std::string& sounds, 
          const std::string& tuningParams, float maxOcclusion);
+    Door(std::string name, InternedString sounds,
+         InternedString tuningParams, float maxOcclusion);
 
     // Getters
     const std::string& getName() const { return name; }
-    const std::string& getSounds() const { return sounds; }
-    const std::string& getTuningParams() const { return tuningParams; }
+    const std::string& getSounds() const { return sounds.str(); }
+    const std::string& getTuningParams() const { return tuningParams.str(); }
     float getMaxOcclusion() const { return maxOcclusion; }
 
+    // Pooled handles, for cheap comparisons and copies
+    const InternedString& getInternedSounds() const { return sounds; }
+    const InternedString& getInternedTuningParams() const { return tuningParams; }
+
     // Setters
     void setName(const std::string& newName) { name = newName; }
-    void setSounds(const std::string& newSounds) { sounds = newSounds; }
-    void setTuningParams(const std::string& newParams) { tuningParams = newParams; }
+    void setSounds(const std::string& newSounds) { sounds = InternedString(newSounds); }
+    void setSounds(InternedString newSounds) { sounds = newSounds; }
+    void setTuningParams(const std::string& newParams) { tuningParams = InternedString(newParams); }
+    void setTuningParams(InternedString newParams) { tuningParams = newParams; }
     void setMaxOcclusion(float newOcclusion) { maxOcclusion = newOcclusion; }
 
     // JSON serialization
@@ -28,7 +37,7 @@ public:
 
 private:
     std::string name;
-    std::string sounds;
-    std::string tuningParams;
+    InternedString sounds;        // Shared with every door using the same value
+    InternedString tuningParams;  // Shared with every door using the same value
     float maxOcclusion = 0.7f;
 };
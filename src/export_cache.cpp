@@ -0,0 +1,152 @@
+#include "export_cache.h"
+#include "dat151_writer.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace {
+    std::string toHex(uint64_t value) {
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+        return hex;
+    }
+
+    // Size and modification time identify the file the entry was stored for
+    bool statOutput(const std::string& path, uintmax_t& size, long long& modified) {
+        std::error_code error;
+        size = std::filesystem::file_size(path, error);
+        if (error) {
+            return false;
+        }
+        auto time = std::filesystem::last_write_time(path, error);
+        modified = static_cast<long long>(time.time_since_epoch().count());
+        return !error;
+    }
+}
+
+Fingerprint& Fingerprint::add(std::string_view str) {
+    add(static_cast<uint64_t>(str.size()));
+    addBytes(str.data(), str.size());
+    return *this;
+}
+
+Fingerprint& Fingerprint::add(uint64_t value) {
+    // Byte order fixed so fingerprints do not depend on the platform
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = static_cast<unsigned char>(value >> (i * 8));
+    }
+    addBytes(bytes, sizeof(bytes));
+    return *this;
+}
+
+Fingerprint& Fingerprint::add(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return add(static_cast<uint64_t>(bits));
+}
+
+Fingerprint& Fingerprint::add(const SoundPreset& preset) {
+    return add(preset.name).add(preset.sounds).add(preset.tuningParams).add(preset.maxOcclusion);
+}
+
+void Fingerprint::addBytes(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+uint64_t fingerprintDat151Manifest(std::string_view manifest, const std::vector<SoundPreset>& presets) {
+    Fingerprint fingerprint;
+    fingerprint.add(static_cast<uint64_t>(Dat151Writer::VERSION))
+               .add(static_cast<uint64_t>(Dat151Writer::FORMAT_REVISION))
+               .add(manifest)
+               .add(static_cast<uint64_t>(presets.size()));
+    for (const auto& preset : presets) {
+        fingerprint.add(preset);
+    }
+    return fingerprint.value();
+}
+
+ExportCache::ExportCache(std::string directory) : directory(std::move(directory)) {
+}
+
+bool ExportCache::isUpToDate(const std::string& outputPath, uint64_t fingerprint) const {
+    std::string absoluteOutput;
+    std::ifstream file(entryPath(outputPath, absoluteOutput));
+    if (!file.is_open()) {
+        return false;
+    }
+    nlohmann::json entry = nlohmann::json::parse(file, nullptr, false);
+    if (entry.is_discarded() || !entry.is_object()) {
+        return false;
+    }
+
+    uintmax_t size = 0;
+    long long modified = 0;
+    if (!statOutput(outputPath, size, modified)) {
+        return false;
+    }
+    return entry.value("output", "") == absoluteOutput &&
+           entry.value("fingerprint", "") == toHex(fingerprint) &&
+           entry.value("size", static_cast<uintmax_t>(0)) == size &&
+           entry.value("modified", 0LL) == modified;
+}
+
+bool ExportCache::store(const std::string& outputPath, uint64_t fingerprint) const {
+    std::string absoluteOutput;
+    std::string path = entryPath(outputPath, absoluteOutput);
+
+    uintmax_t size = 0;
+    long long modified = 0;
+    std::error_code error;
+    if (!statOutput(outputPath, size, modified)) {
+        std::cerr << "Error updating export cache, cannot read " << outputPath << std::endl;
+        return false;
+    }
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Error creating export cache directory: " << directory << std::endl;
+        return false;
+    }
+
+    nlohmann::json entry;
+    entry["output"] = absoluteOutput;
+    entry["fingerprint"] = toHex(fingerprint);
+    entry["size"] = size;
+    entry["modified"] = modified;
+
+    // Replaced atomically, a concurrent reader sees the old entry or the new one
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file << entry.dump();
+        if (!file) {
+            std::cerr << "Error writing export cache entry: " << tempPath << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "Error writing export cache entry: " << path << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+std::string ExportCache::entryPath(const std::string& outputPath, std::string& absoluteOutput) const {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(outputPath, error);
+    absoluteOutput = (error ? std::filesystem::path(outputPath) : absolute).lexically_normal().string();
+
+    // Entries are named after the output they describe
+    std::filesystem::path entry(directory);
+    entry /= toHex(Fingerprint().add(absoluteOutput).value()) + ".json";
+    return entry.string();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "settings_manager.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 64-bit FNV-1a hash of export inputs
+ * Strings are hashed with their length so that concatenations of
+ * different fields never collide by construction.
+ */
+class Fingerprint {
+public:
+    Fingerprint& add(std::string_view str);
+    Fingerprint& add(uint64_t value);
+    Fingerprint& add(float value);
+    Fingerprint& add(const SoundPreset& preset);
+
+    uint64_t value() const { return hash; }
+
+private:
+    void addBytes(const void* data, size_t size);
+
+    uint64_t hash = 14695981039346656037ull;
+};
+
+/**
+ * Fingerprint of a dat151 export of a manifest, without parsing it
+ * Covers the manifest text, every preset value, the resource version and the
+ * writer's format revision. The export command and the daemon both use it,
+ * so they can share a cache directory.
+ */
+uint64_t fingerprintDat151Manifest(std::string_view manifest, const std::vector<SoundPreset>& presets);
+
+/**
+ * Record of the fingerprint each output file was last written from
+ * One small entry per output is kept in the cache directory. An output is
+ * up to date when its entry holds the same fingerprint and the file still
+ * has the size and modification time recorded after it was written, so an
+ * output edited or replaced by something else is rebuilt.
+ */
+class ExportCache {
+public:
+    explicit ExportCache(std::string directory);
+
+    /**
+     * Check if an output was written from the same inputs and left untouched since
+     * @param outputPath Path of the exported file
+     * @param fingerprint Fingerprint of the inputs the file would be written from
+     * @return true if writing the file again can be skipped, false otherwise
+     */
+    bool isUpToDate(const std::string& outputPath, uint64_t fingerprint) const;
+
+    /**
+     * Remember the fingerprint of an output that was just written
+     * @param outputPath Path of the exported file
+     * @param fingerprint Fingerprint of the inputs the file was written from
+     * @return true if the entry was stored, false otherwise
+     */
+    bool store(const std::string& outputPath, uint64_t fingerprint) const;
+
+private:
+    std::string entryPath(const std::string& outputPath, std::string& absoluteOutput) const;
+
+    std::string directory;
+};
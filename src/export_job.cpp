@@ -0,0 +1,77 @@
+#include "export_job.h"
+#include "dat151.h"
+#include <chrono>
+
+ExportJob::~ExportJob() {
+    cancel();
+    join();
+}
+
+bool ExportJob::start(std::vector<Door> snapshot, const std::string& path) {
+    if (isRunning()) {
+        return false;
+    }
+    join();
+
+    doors = std::move(snapshot);
+    filePath = path;
+    totalItems = doors.size() * 2;  // One DoorAudioSettings and one DoorAudioSettingsLink per door
+    itemsWritten = 0;
+    elapsedMicroseconds = 0;
+    cancelRequested = false;
+    status = Status::Running;
+
+    worker = std::thread(&ExportJob::run, this);
+    return true;
+}
+
+void ExportJob::reset() {
+    if (isRunning()) {
+        return;
+    }
+    join();
+    status = Status::Idle;
+}
+
+double ExportJob::getItemsPerSecond() const {
+    long long elapsed = elapsedMicroseconds;
+    if (elapsed <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(itemsWritten) * 1000000.0 / static_cast<double>(elapsed);
+}
+
+void ExportJob::run() {
+    auto startTime = std::chrono::steady_clock::now();
+    auto updateProgress = [&](size_t written) {
+        itemsWritten = written;
+        elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        if (onProgress) {
+            onProgress();
+        }
+    };
+
+    bool written = writeDat151File(doors, filePath, [&](size_t count) {
+        updateProgress(count);
+        return !cancelRequested;
+    });
+
+    // Release the snapshot before reporting the result
+    std::vector<Door>().swap(doors);
+
+    if (written) {
+        status = Status::Completed;
+    } else if (cancelRequested) {
+        status = Status::Cancelled;
+    } else {
+        status = Status::Failed;
+    }
+    updateProgress(itemsWritten);
+}
+
+void ExportJob::join() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "doors.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Exports a snapshot of the door list to a dat151.rel.xml file on a
+ * background thread
+ * Progress counters can be read from any thread while the job runs. The
+ * output file is replaced atomically once the export has completed.
+ */
+class ExportJob {
+public:
+    enum class Status { Idle, Running, Completed, Failed, Cancelled };
+
+    ExportJob() = default;
+    ~ExportJob();
+
+    ExportJob(const ExportJob&) = delete;
+    ExportJob& operator=(const ExportJob&) = delete;
+
+    /**
+     * Start exporting doors in the background
+     * @param doors Snapshot of the doors to export, owned by the job
+     * @param filePath Path of the XML file to write
+     * @return true if the job was started, false if another export is still running
+     */
+    bool start(std::vector<Door> doors, const std::string& filePath);
+
+    /**
+     * Ask the running export to stop; the existing file is left untouched
+     */
+    void cancel() { cancelRequested = true; }
+
+    /**
+     * Forget the result of a finished export and go back to Idle
+     */
+    void reset();
+
+    /**
+     * Set a callback invoked from the worker thread whenever progress is made
+     * or the job finishes
+     */
+    void setOnProgress(std::function<void()> callback) { onProgress = std::move(callback); }
+
+    Status getStatus() const { return status; }
+    bool isRunning() const { return status == Status::Running; }
+    size_t getItemsWritten() const { return itemsWritten; }
+    size_t getTotalItems() const { return totalItems; }
+
+    /**
+     * Average export speed since the job started
+     */
+    double getItemsPerSecond() const;
+
+private:
+    void run();
+    void join();
+
+    std::thread worker;
+    std::vector<Door> doors;
+    std::string filePath;
+    std::function<void()> onProgress;
+    std::atomic<Status> status{Status::Idle};
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<size_t> itemsWritten{0};
+    std::atomic<long long> elapsedMicroseconds{0};
+    size_t totalItems = 0;
+};
@@ -0,0 +1,195 @@
+#include "import_job.h"
+#include "dat151.h"
+#include "door_csv.h"
+#include <filesystem>
+
+ImportJob::~ImportJob() {
+    cancel();
+    join();
+}
+
+bool ImportJob::start(const std::string& path, PresetIndex presetIndex) {
+    if (!canStart()) {
+        return false;
+    }
+    join();
+
+    filePath = path;
+    presets = std::move(presetIndex);
+    bytesProcessed = 0;
+    totalBytes = 0;
+    doorsParsed = 0;
+    rowsSkipped = 0;
+    cancelRequested = false;
+    {
+        std::lock_guard<std::mutex> lock(batchesMutex);
+        batches.clear();
+    }
+    workerStatus = Status::Running;
+    workerDone = false;
+
+    worker = std::thread(&ImportJob::run, this);
+    return true;
+}
+
+bool ImportJob::isDelimitedTextFile(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    for (char& c : extension) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return extension == ".csv" || extension == ".tsv" || extension == ".txt";
+}
+
+void ImportJob::cancel() {
+    // Returns without waiting, the worker is reaped by getStatus once it
+    // notices the flag
+    cancelRequested = true;
+
+    std::lock_guard<std::mutex> lock(batchesMutex);
+    bool hasPendingBatches = !batches.empty();
+    batches.clear();
+
+    // Failed and fully committed imports keep their status
+    Status status = Status::Running;
+    if (!workerStatus.compare_exchange_strong(status, Status::Cancelled) &&
+        status == Status::Completed && hasPendingBatches) {
+        workerStatus = Status::Cancelled;
+    }
+}
+
+void ImportJob::reset() {
+    if (isRunning()) {
+        return;
+    }
+    workerStatus = Status::Idle;
+}
+
+bool ImportJob::canStart() {
+    return !isRunning() && (!worker.joinable() || workerDone);
+}
+
+bool ImportJob::takeBatch(std::vector<Door>& batch) {
+    std::lock_guard<std::mutex> lock(batchesMutex);
+    if (cancelRequested || batches.empty()) {
+        return false;
+    }
+    batch = std::move(batches.front());
+    batches.pop_front();
+    return true;
+}
+
+ImportJob::Status ImportJob::getStatus() {
+    // Reap a worker that has finished, e.g. after a cancel
+    if (workerDone && worker.joinable()) {
+        worker.join();
+    }
+
+    Status status = workerStatus;
+    if (status == Status::Completed) {
+        // Parsing is done but the owner has not committed everything yet
+        std::lock_guard<std::mutex> lock(batchesMutex);
+        if (!batches.empty()) {
+            return Status::Running;
+        }
+    }
+    return status;
+}
+
+void ImportJob::run() {
+    std::vector<Door> batch;
+    batch.reserve(BATCH_SIZE);
+    bool isRead = isDelimitedTextFile(filePath) ? readDelimitedText(batch) : readXml(batch);
+
+    // A cancelled job keeps its status, the worker only finishes a running one
+    Status running = Status::Running;
+    if (!isRead) {
+        workerStatus.compare_exchange_strong(running, Status::Failed);
+    } else if (!cancelRequested) {
+        pushBatch(batch);
+        bytesProcessed = totalBytes.load();
+        workerStatus.compare_exchange_strong(running, Status::Completed);
+    }
+    if (onProgress) {
+        onProgress();
+    }
+    workerDone = true;
+}
+
+bool ImportJob::readXml(std::vector<Door>& batch) {
+    Dat151Reader reader;
+    if (!reader.open(filePath)) {
+        return false;
+    }
+    totalBytes = reader.getFileSize();
+
+    reader.forEachDoor([&](const DoorRecordView& record) {
+        if (cancelRequested) {
+            return false;
+        }
+
+        batch.push_back(record.toDoor());
+        if (record.fileOffset > bytesProcessed) {
+            bytesProcessed = record.fileOffset;
+        }
+        if (batch.size() == BATCH_SIZE) {
+            pushBatch(batch);
+        }
+        return true;
+    });
+    return true;
+}
+
+bool ImportJob::readDelimitedText(std::vector<Door>& batch) {
+    DoorCsvReader reader;
+    if (!reader.open(filePath, presets)) {
+        return false;
+    }
+    totalBytes = reader.getFileSize();
+
+    reader.forEachDoor([&](Door& door, size_t fileOffset) {
+        if (cancelRequested) {
+            return false;
+        }
+
+        batch.push_back(std::move(door));
+        bytesProcessed = fileOffset;
+        rowsSkipped = reader.getSkippedRows();
+        if (batch.size() == BATCH_SIZE) {
+            pushBatch(batch);
+        }
+        return true;
+    });
+    rowsSkipped = reader.getSkippedRows();
+    return true;
+}
+
+void ImportJob::pushBatch(std::vector<Door>& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    {
+        // Batches parsed after a cancel are dropped, the owner already rolled back
+        std::lock_guard<std::mutex> lock(batchesMutex);
+        if (cancelRequested) {
+            batch.clear();
+            return;
+        }
+        doorsParsed += batch.size();
+        batches.push_back(std::move(batch));
+    }
+    batch.clear();
+    batch.reserve(BATCH_SIZE);
+
+    if (onProgress) {
+        onProgress();
+    }
+}
+
+void ImportJob::join() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
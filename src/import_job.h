@@ -0,0 +1,109 @@
+#pragma once
+
+#include "doors.h"
+#include "preset_index.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Parses a dat151.rel.xml, CSV or TSV file on a background thread
+ * Doors are handed over in batches that the owner commits to its door list
+ * between frames, so the UI keeps running while large files load.
+ */
+class ImportJob {
+public:
+    enum class Status { Idle, Running, Completed, Failed, Cancelled };
+
+    // Number of doors per batch handed to the owner
+    static constexpr size_t BATCH_SIZE = 1024;
+
+    ImportJob() = default;
+    ~ImportJob();
+
+    ImportJob(const ImportJob&) = delete;
+    ImportJob& operator=(const ImportJob&) = delete;
+
+    /**
+     * Start parsing a file in the background
+     * Files ending in .csv, .tsv or .txt are read as delimited text, see DoorCsvReader.
+     * @param filePath Path of the file to read
+     * @param presets Presets that delimited text rows may refer to by name
+     * @return true if the job was started, false if another import is still running
+     */
+    bool start(const std::string& filePath, PresetIndex presets = PresetIndex());
+
+    /**
+     * Check if a file is read as delimited text rather than dat151 XML
+     */
+    static bool isDelimitedTextFile(const std::string& filePath);
+
+    /**
+     * Stop parsing and drop the batches that were not committed yet
+     * Returns immediately; the worker finishes in the background and is
+     * reaped by a later getStatus. Batches already taken with takeBatch are
+     * the owner's to roll back.
+     */
+    void cancel();
+
+    /**
+     * Check if a new import can start
+     * @return false while running or while the worker of a cancelled import is still finishing
+     */
+    bool canStart();
+
+    /**
+     * Forget the result of a finished import and go back to Idle
+     */
+    void reset();
+
+    /**
+     * Take the next parsed batch, if any
+     * @param batch Receives the doors of the batch in file order
+     * @return true if a batch was available, false otherwise
+     */
+    bool takeBatch(std::vector<Door>& batch);
+
+    /**
+     * Set a callback invoked from the worker thread whenever a batch is ready
+     * or parsing ends
+     */
+    void setOnProgress(std::function<void()> callback) { onProgress = std::move(callback); }
+
+    /**
+     * Running until parsing has ended and every batch has been taken
+     */
+    Status getStatus();
+    bool isRunning() { return getStatus() == Status::Running; }
+    size_t getBytesProcessed() const { return bytesProcessed; }
+    size_t getTotalBytes() const { return totalBytes; }
+    size_t getDoorsParsed() const { return doorsParsed; }
+    size_t getRowsSkipped() const { return rowsSkipped; }
+
+private:
+    void run();
+    bool readXml(std::vector<Door>& batch);
+    bool readDelimitedText(std::vector<Door>& batch);
+    void pushBatch(std::vector<Door>& batch);
+    void join();
+
+    std::thread worker;
+    std::string filePath;
+    PresetIndex presets;
+    std::function<void()> onProgress;
+    std::atomic<Status> workerStatus{Status::Idle};
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<bool> workerDone{true};     // Set by the worker as its last action
+    std::atomic<size_t> bytesProcessed{0};
+    std::atomic<size_t> totalBytes{0};
+    std::atomic<size_t> doorsParsed{0};
+    std::atomic<size_t> rowsSkipped{0};
+
+    std::mutex batchesMutex;
+    std::deque<std::vector<Door>> batches;
+};
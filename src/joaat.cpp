@@ -0,0 +1,12 @@
+#include "joaat.h"
+
+// The hash is verified against known game hashes at compile time
+static_assert("door_name_01"_joaat == 0x61975108, "joaat mismatch");
+
+void formatJoaatHex(uint32_t hash, char* out) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = static_cast<int>(JOAAT_HEX_LENGTH) - 1; i >= 0; i--) {
+        out[i] = digits[hash & 0xf];
+        hash >>= 4;
+    }
+}
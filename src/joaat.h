@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Length of a joaat hash formatted as lowercase hexadecimal
+ */
+constexpr size_t JOAAT_HEX_LENGTH = 8;
+
+/**
+ * Compute the Jenkins one-at-a-time hash of a string, as used by the game
+ * for item names. ASCII letters are lowercased before hashing.
+ * Usable in constant expressions, e.g. as a switch case label.
+ * @param str String to hash
+ * @return The raw 32-bit hash
+ */
+constexpr uint32_t joaat(std::string_view str) {
+    uint32_t hash = 0;
+
+    for (char c : str) {
+        // Same result as std::tolower in the "C" locale, without the call
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        hash += static_cast<uint32_t>(c);
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash;
+}
+
+/**
+ * Compile-time joaat of a string literal: "DoorAudioSettings"_joaat
+ */
+constexpr uint32_t operator""_joaat(const char* str, size_t length) {
+    return joaat(std::string_view(str, length));
+}
+
+/**
+ * Hash several strings at once with the same result as joaat()
+ * Uses one string per SIMD lane (AVX2 when the CPU supports it, SSE2
+ * otherwise on x86) and falls back to the scalar loop elsewhere.
+ * @param names Strings to hash
+ * @param count Number of strings
+ * @param hashes Receives one hash per string
+ */
+void joaatBatch(const std::string_view* names, size_t count, uint32_t* hashes);
+
+/**
+ * Format a hash as 8 lowercase hexadecimal digits, zero-padded
+ * Does not allocate; no null terminator is written.
+ * @param hash Hash to format
+ * @param out Buffer receiving exactly JOAAT_HEX_LENGTH characters
+ */
+void formatJoaatHex(uint32_t hash, char* out);
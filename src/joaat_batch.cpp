@@ -0,0 +1,209 @@
+#include "joaat.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define JOAAT_X86_SIMD 1
+#include <immintrin.h>
+#include <cstring>
+#else
+#define JOAAT_X86_SIMD 0
+#endif
+
+#if JOAAT_X86_SIMD
+
+/**
+ * Load the 8 bytes of a name starting at offset, zero-padded past its end
+ * @param full true when the name is known to have 8 bytes left
+ */
+static inline long long loadBlock(std::string_view name, size_t offset, bool full) {
+    uint64_t block = 0;
+    if (full) {
+        std::memcpy(&block, name.data() + offset, 8);
+    } else if (offset < name.size()) {
+        size_t remaining = name.size() - offset;
+        std::memcpy(&block, name.data() + offset, remaining < 8 ? remaining : 8);
+    }
+    return static_cast<long long>(block);
+}
+
+/**
+ * Widen byte `Byte` of every 32-bit lane the same way char -> uint32_t
+ * does in joaat(), so results match the scalar version bit for bit
+ */
+template <int Byte>
+static inline __m128i extractByte(__m128i chunk) {
+    __m128i c = _mm_srai_epi32(_mm_slli_epi32(chunk, 24 - 8 * Byte), 24);
+    if (static_cast<char>(-1) > 0) {
+        c = _mm_and_si128(c, _mm_set1_epi32(0xff));
+    }
+    return c;
+}
+
+template <int Byte>
+__attribute__((target("avx2")))
+static inline __m256i extractByte(__m256i chunk) {
+    __m256i c = _mm256_srai_epi32(_mm256_slli_epi32(chunk, 24 - 8 * Byte), 24);
+    if (static_cast<char>(-1) > 0) {
+        c = _mm256_and_si256(c, _mm256_set1_epi32(0xff));
+    }
+    return c;
+}
+
+/**
+ * One joaat round on 4 lanes; lanes that are not active keep their hash
+ */
+static inline __m128i roundSse2(__m128i hash, __m128i c, __m128i active, bool allActive) {
+    // Lowercase ASCII letters
+    __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi32(c, _mm_set1_epi32('A' - 1)),
+                                    _mm_cmplt_epi32(c, _mm_set1_epi32('Z' + 1)));
+    c = _mm_add_epi32(c, _mm_and_si128(isUpper, _mm_set1_epi32('a' - 'A')));
+
+    __m128i next = _mm_add_epi32(hash, c);
+    next = _mm_add_epi32(next, _mm_slli_epi32(next, 10));
+    next = _mm_xor_si128(next, _mm_srli_epi32(next, 6));
+    if (allActive) {
+        return next;
+    }
+    return _mm_or_si128(_mm_and_si128(active, next), _mm_andnot_si128(active, hash));
+}
+
+/**
+ * One joaat round on 8 lanes; lanes that are not active keep their hash
+ */
+__attribute__((target("avx2")))
+static inline __m256i roundAvx2(__m256i hash, __m256i c, __m256i active, bool allActive) {
+    // Lowercase ASCII letters
+    __m256i isUpper = _mm256_and_si256(_mm256_cmpgt_epi32(c, _mm256_set1_epi32('A' - 1)),
+                                       _mm256_cmpgt_epi32(_mm256_set1_epi32('Z' + 1), c));
+    c = _mm256_add_epi32(c, _mm256_and_si256(isUpper, _mm256_set1_epi32('a' - 'A')));
+
+    __m256i next = _mm256_add_epi32(hash, c);
+    next = _mm256_add_epi32(next, _mm256_slli_epi32(next, 10));
+    next = _mm256_xor_si256(next, _mm256_srli_epi32(next, 6));
+    if (allActive) {
+        return next;
+    }
+    return _mm256_or_si256(_mm256_and_si256(active, next), _mm256_andnot_si256(active, hash));
+}
+
+template <int Lanes>
+static void lengthRange(const std::string_view* names, int32_t* lengths, size_t& minLength, size_t& maxLength) {
+    minLength = names[0].size();
+    maxLength = names[0].size();
+    for (int lane = 0; lane < Lanes; lane++) {
+        lengths[lane] = static_cast<int32_t>(names[lane].size());
+        minLength = names[lane].size() < minLength ? names[lane].size() : minLength;
+        maxLength = names[lane].size() > maxLength ? names[lane].size() : maxLength;
+    }
+}
+
+/**
+ * Hash 4 names at once, one name per 32-bit lane
+ */
+static void joaatBatch4Sse2(const std::string_view* names, uint32_t* hashes) {
+    alignas(16) int32_t lengthLanes[4];
+    size_t minLength, maxLength;
+    lengthRange<4>(names, lengthLanes, minLength, maxLength);
+
+    const __m128i lengths = _mm_load_si128(reinterpret_cast<const __m128i*>(lengthLanes));
+    __m128i hash = _mm_setzero_si128();
+    for (size_t offset = 0; offset < maxLength; offset += 8) {
+        bool allActive = offset + 8 <= minLength;
+        __m128i first = _mm_set_epi64x(loadBlock(names[1], offset, allActive), loadBlock(names[0], offset, allActive));
+        __m128i second = _mm_set_epi64x(loadBlock(names[3], offset, allActive), loadBlock(names[2], offset, allActive));
+
+        // Split every 8-byte block into bytes 0-3 (low) and 4-7 (high)
+        __m128i low = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(first), _mm_castsi128_ps(second), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i high = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(first), _mm_castsi128_ps(second), _MM_SHUFFLE(3, 1, 3, 1)));
+
+#define JOAAT_SSE2_ROUND(chunk, byte, position) \
+        hash = roundSse2(hash, extractByte<byte>(chunk), \
+                         _mm_cmpgt_epi32(lengths, _mm_set1_epi32(static_cast<int32_t>(offset + position))), allActive)
+        JOAAT_SSE2_ROUND(low, 0, 0);
+        JOAAT_SSE2_ROUND(low, 1, 1);
+        JOAAT_SSE2_ROUND(low, 2, 2);
+        JOAAT_SSE2_ROUND(low, 3, 3);
+        JOAAT_SSE2_ROUND(high, 0, 4);
+        JOAAT_SSE2_ROUND(high, 1, 5);
+        JOAAT_SSE2_ROUND(high, 2, 6);
+        JOAAT_SSE2_ROUND(high, 3, 7);
+#undef JOAAT_SSE2_ROUND
+    }
+
+    hash = _mm_add_epi32(hash, _mm_slli_epi32(hash, 3));
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 11));
+    hash = _mm_add_epi32(hash, _mm_slli_epi32(hash, 15));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hashes), hash);
+}
+
+/**
+ * Hash 8 names at once, one name per 32-bit lane
+ */
+__attribute__((target("avx2")))
+static void joaatBatch8Avx2(const std::string_view* names, uint32_t* hashes) {
+    alignas(32) int32_t lengthLanes[8];
+    size_t minLength, maxLength;
+    lengthRange<8>(names, lengthLanes, minLength, maxLength);
+
+    const __m256i lengths = _mm256_load_si256(reinterpret_cast<const __m256i*>(lengthLanes));
+    __m256i hash = _mm256_setzero_si256();
+    const __m256i splitHalves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    for (size_t offset = 0; offset < maxLength; offset += 8) {
+        bool allActive = offset + 8 <= minLength;
+        __m256i first = _mm256_setr_epi64x(loadBlock(names[0], offset, allActive), loadBlock(names[1], offset, allActive),
+                                           loadBlock(names[2], offset, allActive), loadBlock(names[3], offset, allActive));
+        __m256i second = _mm256_setr_epi64x(loadBlock(names[4], offset, allActive), loadBlock(names[5], offset, allActive),
+                                            loadBlock(names[6], offset, allActive), loadBlock(names[7], offset, allActive));
+
+        // Split every 8-byte block into bytes 0-3 (low) and 4-7 (high)
+        first = _mm256_permutevar8x32_epi32(first, splitHalves);
+        second = _mm256_permutevar8x32_epi32(second, splitHalves);
+        __m256i low = _mm256_permute2x128_si256(first, second, 0x20);
+        __m256i high = _mm256_permute2x128_si256(first, second, 0x31);
+
+#define JOAAT_AVX2_ROUND(chunk, byte, position) \
+        hash = roundAvx2(hash, extractByte<byte>(chunk), \
+                         _mm256_cmpgt_epi32(lengths, _mm256_set1_epi32(static_cast<int32_t>(offset + position))), allActive)
+        JOAAT_AVX2_ROUND(low, 0, 0);
+        JOAAT_AVX2_ROUND(low, 1, 1);
+        JOAAT_AVX2_ROUND(low, 2, 2);
+        JOAAT_AVX2_ROUND(low, 3, 3);
+        JOAAT_AVX2_ROUND(high, 0, 4);
+        JOAAT_AVX2_ROUND(high, 1, 5);
+        JOAAT_AVX2_ROUND(high, 2, 6);
+        JOAAT_AVX2_ROUND(high, 3, 7);
+#undef JOAAT_AVX2_ROUND
+    }
+
+    hash = _mm256_add_epi32(hash, _mm256_slli_epi32(hash, 3));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 11));
+    hash = _mm256_add_epi32(hash, _mm256_slli_epi32(hash, 15));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes), hash);
+}
+
+static bool cpuHasAvx2() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+
+#endif
+
+void joaatBatch(const std::string_view* names, size_t count, uint32_t* hashes) {
+    size_t i = 0;
+
+#if JOAAT_X86_SIMD
+    if (cpuHasAvx2()) {
+        for (; i + 8 <= count; i += 8) {
+            joaatBatch8Avx2(names + i, hashes + i);
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        joaatBatch4Sse2(names + i, hashes + i);
+    }
+#endif
+
+    // Scalar fallback for the remaining names and non-x86 targets
+    for (; i < count; i++) {
+        hashes[i] = joaat(names[i]);
+    }
+}
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <string>
+#include "cli.h"
 #include "components/mainWindow.h"
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -63,36 +65,81 @@ void cleanup() {
 
 /**
  * Main application entry point
+ * Rendering is on demand: the loop sleeps in glfwWaitEvents until there is
+ * input or a background job posts an update. Pass --continuous to redraw at
+ * vsync rate instead. A command such as "export" runs headless, see cli.h.
  */
-int main() {
+int main(int argc, char** argv) {
+    if (isCliCommand(argc, argv)) {
+        return runCli(argc, argv);
+    }
+
+    bool continuousRendering = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--continuous") {
+            continuousRendering = true;
+        }
+    }
+
     // Initialize GLFW and ImGui
     if (!initGLFW()) {
         return -1;
     }
 
-    // Create main window
-    MainWindow mainWindow;
-
-    // Main loop
-    while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
-
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        // Render main window and its children
-        mainWindow.render();
-
-        // Rendering
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glfwSwapBuffers(window);
+    // Scoped so the window's background jobs are joined before cleanup, their
+    // workers post GLFW events until they stop
+    {
+        // Create main window
+        MainWindow mainWindow;
+
+        // Background jobs wake the loop up from their worker threads
+        mainWindow.setOnRequestRedraw([]() {
+            glfwPostEmptyEvent();
+        });
+
+        // Extra frames drawn after each event so ImGui animations and layout settle
+        const int SETTLE_FRAMES = 3;
+        int framesToRender = SETTLE_FRAMES;
+
+        // Main loop
+        while (!glfwWindowShouldClose(window)) {
+            // Running jobs need a frame each iteration, and a few more once they finish
+            if (mainWindow.hasBackgroundWork()) {
+                framesToRender = SETTLE_FRAMES;
+            }
+
+            if (continuousRendering || framesToRender > 0) {
+                glfwPollEvents();
+            } else if (ImGui::GetIO().WantTextInput) {
+                // Keep the text cursor blinking while an input field is active
+                glfwWaitEventsTimeout(0.5);
+                framesToRender = SETTLE_FRAMES;
+            } else {
+                glfwWaitEvents();
+                framesToRender = SETTLE_FRAMES;
+            }
+
+            // Start the Dear ImGui frame
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+
+            // Render main window and its children
+            mainWindow.render();
+
+            // Rendering
+            ImGui::Render();
+            int display_w, display_h;
+            glfwGetFramebufferSize(window, &display_w, &display_h);
+            glViewport(0, 0, display_w, display_h);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            glfwSwapBuffers(window);
+
+            if (framesToRender > 0) {
+                framesToRender--;
+            }
+        }
     }
 
     cleanup();
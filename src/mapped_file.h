@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only file contents mapped into memory with copy-on-write pages
+ * The mapping is writable so parsers can work on it in place; modified
+ * pages are private to the process and never written back to the file.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file into memory, closing any previously mapped file
+     * @param filePath Path of the file to map
+     * @return true if the file was mapped successfully, false otherwise
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Unmap the file
+     */
+    void close();
+
+    char* getData() const { return data; }
+    size_t getSize() const { return size; }
+    bool isOpen() const { return data != nullptr; }
+
+private:
+    char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,22 @@
+#include "preset_index.h"
+
+PresetIndex::PresetIndex(const std::vector<SoundPreset>& presets) {
+    entries.reserve(presets.size());
+    for (const auto& preset : presets) {
+        // The first preset wins when names are duplicated, like hasSoundPreset
+        if (entries.count(preset.name) > 0) {
+            continue;
+        }
+        names.push_back(preset.name);
+        Entry entry;
+        entry.sounds = InternedString(preset.sounds);
+        entry.tuningParams = InternedString(preset.tuningParams);
+        entry.maxOcclusion = preset.maxOcclusion;
+        entries.emplace(names.back(), entry);
+    }
+}
+
+const PresetIndex::Entry* PresetIndex::find(std::string_view name) const {
+    auto it = entries.find(name);
+    return it != entries.end() ? &it->second : nullptr;
+}
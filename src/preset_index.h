@@ -0,0 +1,46 @@
+#pragma once
+
+#include "settings_manager.h"
+#include "string_pool.h"
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Lookup of sound presets by name
+ * Preset values are interned once, so every door resolved through the index
+ * shares the same sounds and tuning handles. Lookups take a string_view and
+ * do not allocate.
+ */
+class PresetIndex {
+public:
+    struct Entry {
+        InternedString sounds;
+        InternedString tuningParams;
+        float maxOcclusion = 0.7f;
+    };
+
+    PresetIndex() = default;
+    explicit PresetIndex(const std::vector<SoundPreset>& presets);
+
+    // Keys view into names, which only stays valid when moved
+    PresetIndex(const PresetIndex&) = delete;
+    PresetIndex& operator=(const PresetIndex&) = delete;
+    PresetIndex(PresetIndex&&) = default;
+    PresetIndex& operator=(PresetIndex&&) = default;
+
+    /**
+     * Find a preset by name
+     * @param name Preset name, case-sensitive
+     * @return The preset values, or nullptr if there is no such preset
+     */
+    const Entry* find(std::string_view name) const;
+
+    size_t size() const { return entries.size(); }
+
+private:
+    std::deque<std::string> names;                        // Owns the keys of entries
+    std::unordered_map<std::string_view, Entry> entries;  // Views into names
+};
@@ -2,11 +2,14 @@
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h> // For _NSGetExecutablePath on macOS
 #elif defined(_WIN32)
 #include <windows.h>
+#elif defined(__linux__)
+#include <unistd.h> // For readlink on Linux
 #endif
 
 /**
@@ -25,6 +28,12 @@ std::string getExecutablePath() {
     if (GetModuleFileNameA(NULL, path, MAX_PATH) != 0) {
         return std::string(path);
     }
+#elif defined(__linux__)
+    char path[4096];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length > 0) {
+        return std::string(path, static_cast<size_t>(length));
+    }
 #endif
     return "";
 }
@@ -67,21 +76,22 @@ bool tryOpenSettingsFile(const std::string& path, std::ifstream& file) {
 }
 
 /**
- * Load settings from the JSON file
- * If the file doesn't exist or there's an error, use default settings
+ * Get the settings file used by default, next to the executable
  */
-bool SettingsManager::loadSettings() {
+std::string SettingsManager::getDefaultSettingsPath() {
+    return getExecutableDirectory() + "/assets/settings.json";
+}
+
+/**
+ * Read the sound presets of a settings file
+ * Presets that cannot be read are skipped with an error message
+ */
+bool SettingsManager::readPresetsFile(const std::string& path, std::vector<SoundPreset>& presets,
+                                      bool* hasPresetList) {
     try {
-        std::ifstream file;
-        // Obtient le répertoire de l'exécutable
-        std::string exeDir = getExecutableDirectory();
-        std::string settingsFilePath = exeDir + "/assets/settings.json";
-        
-        file.open(settingsFilePath);
+        std::ifstream file(path);
         if (!file.is_open()) {
-            std::cerr << "Error: Could not open settings file at: " << settingsFilePath << std::endl;
-            std::cerr << "Current working directory: " << std::filesystem::current_path().string() << std::endl;
-            std::cerr << "Executable directory: " << exeDir << std::endl;
+            std::cerr << "Error: Could not open settings file at: " << path << std::endl;
             return false;
         }
 
@@ -94,9 +104,11 @@ bool SettingsManager::loadSettings() {
             return false;
         }
 
-        // Load sound presets if present
+        presets.clear();
+        if (hasPresetList) {
+            *hasPresetList = j.contains("availableDoorSound");
+        }
         if (j.contains("availableDoorSound")) {
-            soundPresets.clear();
             for (const auto& preset : j["availableDoorSound"]) {
                 try {
                     SoundPreset p;
@@ -104,17 +116,13 @@ bool SettingsManager::loadSettings() {
                     p.sounds = preset["Sounds"];
                     p.tuningParams = preset["TuningParams"];
                     p.maxOcclusion = preset["MaxOcclusion"];
-                    soundPresets.push_back(p);
+                    presets.push_back(p);
                 } catch (const std::exception& e) {
                     std::cerr << "Error loading preset: " << e.what() << std::endl;
                     continue;
                 }
             }
-            std::cout << "Successfully loaded " << soundPresets.size() << " sound presets" << std::endl;
-        } else {
-            std::cout << "No sound presets found in settings file" << std::endl;
         }
-
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Unexpected error loading settings: " << e.what() << std::endl;
@@ -122,6 +130,32 @@ bool SettingsManager::loadSettings() {
     }
 }
 
+/**
+ * Load settings from the JSON file
+ * If the file doesn't exist or there's an error, use default settings
+ */
+bool SettingsManager::loadSettings() {
+    // Obtient le répertoire de l'exécutable
+    std::string settingsFilePath = getDefaultSettingsPath();
+
+    std::vector<SoundPreset> presets;
+    bool hasPresetList = false;
+    if (!readPresetsFile(settingsFilePath, presets, &hasPresetList)) {
+        std::cerr << "Current working directory: " << std::filesystem::current_path().string() << std::endl;
+        std::cerr << "Executable directory: " << getExecutableDirectory() << std::endl;
+        return false;
+    }
+
+    // A file without the array keeps the current presets, an empty array clears them
+    if (hasPresetList) {
+        soundPresets = std::move(presets);
+        std::cout << "Successfully loaded " << soundPresets.size() << " sound presets" << std::endl;
+    } else {
+        std::cout << "No sound presets found in settings file" << std::endl;
+    }
+    return true;
+}
+
 /**
  * Save current settings to JSON file
  * Includes all sound presets
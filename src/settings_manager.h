@@ -47,6 +47,23 @@ public:
      */
     bool loadSettings();
     
+    /**
+     * Read the sound presets of a settings file without loading them
+     * Used by the headless commands, which do not touch the singleton.
+     * @param path Path to a settings.json file
+     * @param presets Receives the presets found in the file
+     * @param hasPresetList Optional, set to whether the file has an availableDoorSound array
+     * @return true if the file was read successfully, false otherwise
+     */
+    static bool readPresetsFile(const std::string& path, std::vector<SoundPreset>& presets,
+                                bool* hasPresetList = nullptr);
+
+    /**
+     * Path of the settings file loaded at startup
+     * @return The assets/settings.json file next to the executable
+     */
+    static std::string getDefaultSettingsPath();
+
     /**
      * Save current settings to the settings file
      * @return true if settings were saved successfully, false otherwise
@@ -0,0 +1,41 @@
+#include "string_pool.h"
+
+namespace {
+    // Shared by every empty handle, so default construction never touches the pool
+    const std::string& emptyString() {
+        static const std::string empty;
+        return empty;
+    }
+}
+
+InternedString::InternedString() : value(&emptyString()) {}
+
+InternedString::InternedString(std::string_view str) : value(StringPool::getInstance().intern(str)) {}
+
+StringPool& StringPool::getInstance() {
+    static StringPool instance;
+    return instance;
+}
+
+const std::string* StringPool::intern(std::string_view str) {
+    // Empty strings must compare equal to default-constructed handles
+    if (str.empty()) {
+        return &emptyString();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = lookup.find(str);
+    if (it != lookup.end()) {
+        return it->second;
+    }
+
+    const std::string& pooled = strings.emplace_back(str);
+    lookup.emplace(std::string_view(pooled), &pooled);
+    return &pooled;
+}
+
+size_t StringPool::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return strings.size();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Handle to an immutable string owned by the StringPool
+ * Equal strings share the same handle, so copies and comparisons only
+ * touch a pointer.
+ */
+class InternedString {
+public:
+    InternedString();
+    explicit InternedString(std::string_view str);
+
+    const std::string& str() const { return *value; }
+    bool empty() const { return value->empty(); }
+
+    bool operator==(const InternedString& other) const { return value == other.value; }
+    bool operator!=(const InternedString& other) const { return value != other.value; }
+
+private:
+    const std::string* value;
+};
+
+/**
+ * Singleton pool of interned strings
+ * Strings are never released, which keeps every handle valid for the
+ * lifetime of the program. Interning is thread-safe; reading an
+ * InternedString does not touch the pool at all.
+ */
+class StringPool {
+public:
+    /**
+     * Get the singleton instance of StringPool
+     * @return Reference to the StringPool instance
+     */
+    static StringPool& getInstance();
+
+    /**
+     * Get the pooled copy of a string, adding it if needed
+     * @param str String to intern
+     * @return Stable pointer to the pooled string
+     */
+    const std::string* intern(std::string_view str);
+
+    /**
+     * Number of distinct strings in the pool
+     */
+    size_t size();
+
+private:
+    StringPool() = default;  // Private constructor for singleton
+
+    std::mutex mutex;
+    std::deque<std::string> strings;  // Element addresses stay valid on push_back
+    std::unordered_map<std::string_view, const std::string*> lookup;  // Views into strings
+};